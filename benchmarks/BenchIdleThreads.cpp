@@ -0,0 +1,80 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Threads/TaskGroup.h>
+#include <icarus/Threads/ThreadPool.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace icarus;
+
+static constexpr unsigned NumBursts = 2000;
+static constexpr unsigned ForkDepth = 8;
+
+static std::atomic<uint64_t> Sink = 0;
+
+/**
+ * A binary tree of small tasks joined by task groups, similar to the analysis of independent callees.
+ */
+static void fork(unsigned Depth) {
+  uint64_t X = Depth;
+  for (unsigned I = 0; I < 64; ++I)
+    X = X * 6364136223846793005ULL + 1442695040888963407ULL;
+  Sink.fetch_add(X & 1, std::memory_order_relaxed);
+  if (!Depth)
+    return;
+
+  TaskGroup Group;
+  Group.run([Depth]() { fork(Depth - 1); });
+  fork(Depth - 1);
+  Group.wait();
+}
+
+/**
+ * Measure the latency of bursts of forking tasks, separated by pauses in which the workers are idle.
+ * @return The median and the 99th percentile of the burst latencies in microseconds.
+ */
+static std::pair<double, double> run(unsigned NumWorkers, const ThreadPool::IdleOptions &Options,
+                                     std::chrono::microseconds Pause) {
+  ThreadPool::setIdleOptions(Options);
+  ThreadPool::initialize(NumWorkers + 1);
+
+  std::vector<double> Latencies;
+  for (unsigned Burst = 0; Burst < NumBursts; ++Burst) {
+    auto Start = std::chrono::steady_clock::now();
+    fork(ForkDepth);
+    auto End = std::chrono::steady_clock::now();
+    Latencies.push_back(std::chrono::duration<double, std::micro>(End - Start).count());
+
+    /* Busy waiting, so that the main thread does not sleep itself */
+    for (auto Until = End + Pause; std::chrono::steady_clock::now() < Until;)
+      ;
+  }
+
+  ThreadPool::shutdown();
+  std::sort(Latencies.begin(), Latencies.end());
+  return {Latencies[Latencies.size() / 2], Latencies[Latencies.size() * 99 / 100]};
+}
+
+int main() {
+  unsigned NumWorkers = std::max(2U, std::thread::hardware_concurrency()) - 1;
+
+  struct Strategy {
+    const char *Name;
+    ThreadPool::IdleOptions Options;
+  };
+  std::vector<Strategy> Strategies = {{"sleep", {0, 0}}, {"default", {}}, {"spin-long", {1024, 1024}}};
+
+  std::printf("%-10s %-10s %16s %16s\n", "Pause (us)", "Strategy", "Median (us)", "P99 (us)");
+  for (unsigned Pause : {0U, 50U, 1000U}) {
+    for (const Strategy &S : Strategies) {
+      auto [Median, P99] = run(NumWorkers, S.Options, std::chrono::microseconds(Pause));
+      std::printf("%-10u %-10s %16.1f %16.1f\n", Pause, S.Name, Median, P99);
+    }
+  }
+  return 0;
+}
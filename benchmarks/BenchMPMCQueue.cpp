@@ -0,0 +1,73 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Threads/MPMCQueue.h>
+#include <icarus/Threads/ThreadSafeQueue.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace icarus;
+
+struct LockedQueue : public ThreadSafeQueue<LockedQueue, uint64_t> {};
+struct LockFreeQueue : public MPMCQueue<LockFreeQueue, uint64_t> {};
+
+static constexpr uint64_t NumElements = 1 << 20;
+
+/**
+ * Push a total of NumElements elements from the producers, which are popped by the consumers in blocking
+ * mode. Each consumer stops after receiving a zero element, which is pushed after all producers finished.
+ * @return The number of elements per second.
+ */
+template <typename Queue> static double run(unsigned NumProducers, unsigned NumConsumers) {
+  Queue Q;
+  std::atomic<uint64_t> Sum = 0;
+  std::vector<std::thread> Producers, Consumers;
+
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned N = 0; N < NumConsumers; ++N) {
+    Consumers.emplace_back([&]() {
+      uint64_t Value, Local = 0;
+      while (Q.pop(Value) && Value)
+        Local += Value;
+      Sum.fetch_add(Local);
+    });
+  }
+  for (unsigned N = 0; N < NumProducers; ++N) {
+    Producers.emplace_back([&, N]() {
+      for (uint64_t Value = N + 1; Value <= NumElements; Value += NumProducers)
+        Q.push(uint64_t(Value));
+    });
+  }
+
+  for (std::thread &Producer : Producers)
+    Producer.join();
+  for (unsigned N = 0; N < NumConsumers; ++N)
+    Q.push(0);
+  for (std::thread &Consumer : Consumers)
+    Consumer.join();
+  auto End = std::chrono::steady_clock::now();
+
+  if (Sum.load() != NumElements * (NumElements + 1) / 2)
+    std::printf("Lost elements in queue!\n");
+  return NumElements / std::chrono::duration<double>(End - Start).count();
+}
+
+int main() {
+  unsigned MaxThreads = std::max(2U, std::thread::hardware_concurrency());
+
+  std::printf("%-10s %-10s %20s %20s %10s\n", "Producers", "Consumers", "ThreadSafeQueue/s", "MPMCQueue/s", "Speedup");
+  for (unsigned NumThreads = 1; 2 * NumThreads <= MaxThreads || NumThreads == 1; NumThreads *= 2) {
+    for (auto [NumProducers, NumConsumers] : {std::pair{NumThreads, NumThreads}, std::pair{NumThreads, 1U}}) {
+      double Locked = run<LockedQueue>(NumProducers, NumConsumers);
+      double LockFree = run<LockFreeQueue>(NumProducers, NumConsumers);
+      std::printf("%-10u %-10u %20.0f %20.0f %9.2fx\n", NumProducers, NumConsumers, Locked, LockFree,
+                  LockFree / Locked);
+      if (NumThreads == 1)
+        break;
+    }
+  }
+  return 0;
+}
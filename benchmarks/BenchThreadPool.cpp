@@ -0,0 +1,166 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Threads/ThreadPool.h>
+#include <icarus/Threads/ThreadSafeQueue.h>
+
+#include <chrono>
+#include <cstdio>
+
+using namespace icarus;
+
+/**
+ * The previous task type of ThreadPool: A virtual interface, implemented for each packaged task type.
+ */
+struct LegacyTask {
+  virtual ~LegacyTask() = default;
+  virtual void execute() = 0;
+};
+
+template <typename Func> class LegacyThreadTask : public LegacyTask {
+  Func ThreadFunction;
+
+public:
+  explicit LegacyThreadTask(Func &&Function) : ThreadFunction(std::move(Function)) {}
+
+  void execute() override {
+    ThreadFunction();
+  }
+};
+
+/**
+ * The previous design of ThreadPool: All tasks are pushed to a single locked queue, and the workers block
+ * in ThreadSafeQueue::pop until a task is available. Each task allocates the packaged task, its shared
+ * state and the task object.
+ */
+class LegacyThreadPool {
+
+  struct TaskQueue : public ThreadSafeQueue<TaskQueue, std::unique_ptr<LegacyTask>> {};
+
+  std::atomic_bool Running = false;
+  TaskQueue Tasks;
+  std::atomic_uint TotalTasks = 0;
+  std::vector<std::thread> Threads;
+  std::shared_mutex Mutex;
+  std::condition_variable_any Condition;
+
+  void worker() {
+    while (Running) {
+      std::unique_ptr<LegacyTask> T;
+      if (Tasks.pop(T)) {
+        T->execute();
+        --TotalTasks;
+        Condition.notify_one();
+      }
+    }
+  }
+
+public:
+  explicit LegacyThreadPool(unsigned NumWorkers) {
+    Running = true;
+    for (unsigned N = 0; N < NumWorkers; ++N)
+      Threads.emplace_back(&LegacyThreadPool::worker, this);
+  }
+
+  ~LegacyThreadPool() {
+    Running = false;
+    Tasks.invalidate();
+    for (std::thread &Thread : Threads)
+      Thread.join();
+  }
+
+  template <typename Func> auto submit(Func &&Function) {
+    using PTask = std::packaged_task<void()>;
+    PTask PackagedTask(std::forward<Func>(Function));
+    std::future<void> Future(PackagedTask.get_future());
+    Tasks.push(std::make_unique<LegacyThreadTask<PTask>>(std::move(PackagedTask)));
+    ++TotalTasks;
+    return Future;
+  }
+
+  void awaitCompletion() {
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    Condition.wait(Lock, [&]() { return TotalTasks == 0; });
+  }
+};
+
+/**
+ * Adapter for the global ThreadPool with the same interface as LegacyThreadPool.
+ */
+struct GlobalThreadPool {
+  explicit GlobalThreadPool(unsigned NumWorkers) {
+    ThreadPool::initialize(NumWorkers + 1);
+  }
+
+  ~GlobalThreadPool() {
+    ThreadPool::shutdown();
+  }
+
+  template <typename Func> auto submit(Func &&Function) {
+    return ThreadPool::submit(std::forward<Func>(Function));
+  }
+
+  void awaitCompletion() {
+    ThreadPool::awaitCompletion();
+  }
+};
+
+static constexpr unsigned NumExternalTasks = 1 << 17;
+static constexpr unsigned TreeDepth = 17;
+
+static std::atomic<uint64_t> Sink = 0;
+
+/**
+ * A small amount of work, so that the scheduling overhead dominates.
+ */
+static void work(unsigned N) {
+  uint64_t X = N;
+  for (unsigned I = 0; I < 64; ++I)
+    X = X * 6364136223846793005ULL + 1442695040888963407ULL;
+  Sink.fetch_add(X & 1, std::memory_order_relaxed);
+}
+
+template <typename Pool> static void spawn(Pool &P, unsigned Depth) {
+  work(Depth);
+  if (!Depth)
+    return;
+  P.submit([&P, Depth]() { spawn(P, Depth - 1); });
+  P.submit([&P, Depth]() { spawn(P, Depth - 1); });
+}
+
+/**
+ * Measure the throughput of tasks submitted by the main thread and of tasks submitted by the workers.
+ * @return The number of tasks per second for both workloads.
+ */
+template <typename Pool> static std::pair<double, double> run(unsigned NumWorkers) {
+  Pool P(NumWorkers);
+
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned N = 0; N < NumExternalTasks; ++N)
+    P.submit([N]() { work(N); });
+  P.awaitCompletion();
+  auto Middle = std::chrono::steady_clock::now();
+  P.submit([&P]() { spawn(P, TreeDepth); });
+  P.awaitCompletion();
+  auto End = std::chrono::steady_clock::now();
+
+  double External = NumExternalTasks / std::chrono::duration<double>(Middle - Start).count();
+  double Nested = ((2U << TreeDepth) - 1) / std::chrono::duration<double>(End - Middle).count();
+  return {External, Nested};
+}
+
+int main() {
+  unsigned MaxWorkers = std::max(1U, std::thread::hardware_concurrency());
+
+  std::printf("%-8s %20s %20s %20s %20s\n", "Workers", "Legacy external/s", "Stealing external/s",
+              "Legacy nested/s", "Stealing nested/s");
+  /* Powers of two up to the number of hardware threads, and the number of hardware threads itself */
+  for (unsigned NumWorkers = 1; NumWorkers <= MaxWorkers;
+       NumWorkers = NumWorkers == MaxWorkers ? MaxWorkers + 1 : std::min(NumWorkers * 2, MaxWorkers)) {
+    auto [LegacyExternal, LegacyNested] = run<LegacyThreadPool>(NumWorkers);
+    auto [External, Nested] = run<GlobalThreadPool>(NumWorkers);
+    std::printf("%-8u %20.0f %20.0f %20.0f %20.0f\n", NumWorkers, LegacyExternal, External, LegacyNested, Nested);
+  }
+  return 0;
+}
@@ -0,0 +1,98 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Analysis/EngineValue.h>
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace icarus;
+
+/**
+ * The previous layout of ValueDelegate: A flag and the offset in the first word, followed by either the
+ * pointer to the node or the pointer to the llvm::Value. The copy constructor has to branch on the flag.
+ */
+class LegacyValueDelegate {
+
+  uint64_t isNode : 1;
+  uint64_t Offset : 63;
+
+  union {
+    EngineValue *Node;
+    llvm::Value *CVal;
+  };
+
+public:
+  LegacyValueDelegate() : isNode(0), Offset(0), CVal(nullptr) {}
+  LegacyValueDelegate(EngineValue *Node, uint64_t Offset = 0) : isNode(1), Offset(Offset), Node(Node) {}
+
+  LegacyValueDelegate(const LegacyValueDelegate &Other) : isNode(Other.isNode), Offset(Other.Offset) {
+    if (isNode)
+      Node = Other.Node;
+    else
+      CVal = Other.CVal;
+  }
+
+  LegacyValueDelegate &operator=(const LegacyValueDelegate &Other) = default;
+
+  bool isNodeDelegate() const {
+    return isNode;
+  }
+
+  uint64_t getOffset() const {
+    return Offset;
+  }
+};
+
+static constexpr std::size_t NumDelegates = 1 << 20;
+static constexpr unsigned NumRounds = 32;
+
+/**
+ * Copy an array of delegates and sum up the offsets of the copied delegates for a number of rounds.
+ * @return The time in milliseconds.
+ */
+template <typename Delegate> static double run(const char *Name, std::vector<Delegate> &Source, uint64_t &Sum) {
+  std::vector<Delegate> Target(Source.size());
+
+  auto Start = std::chrono::steady_clock::now();
+  for (unsigned Round = 0; Round < NumRounds; ++Round) {
+    for (std::size_t I = 0; I < Source.size(); ++I)
+      Target[I] = Delegate(Source[I]);
+    for (const Delegate &D : Target)
+      Sum += D.isNodeDelegate() ? D.getOffset() : 1;
+  }
+  auto End = std::chrono::steady_clock::now();
+
+  double Millis = std::chrono::duration<double, std::milli>(End - Start).count();
+  std::printf("%-20s %4zu bytes %10.2f ms %10.2f MiB\n", Name, sizeof(Delegate), Millis,
+              static_cast<double>(Source.size() * sizeof(Delegate)) / (1024 * 1024));
+  return Millis;
+}
+
+int main() {
+  std::vector<EngineValue> Nodes(64);
+  std::vector<LegacyValueDelegate> Legacy;
+  std::vector<ValueDelegate> Compact;
+  Legacy.reserve(NumDelegates);
+  Compact.reserve(NumDelegates);
+
+  /* Mostly small offsets, as produced by struct and array accesses, with a few invalid values */
+  for (std::size_t I = 0; I < NumDelegates; ++I) {
+    if (I % 16 == 0) {
+      Legacy.emplace_back();
+      Compact.emplace_back();
+    } else {
+      Legacy.emplace_back(&Nodes[I % Nodes.size()], (I % 32) * 8);
+      Compact.emplace_back(&Nodes[I % Nodes.size()], (I % 32) * 8);
+    }
+  }
+
+  uint64_t LegacySum = 0, CompactSum = 0;
+  double LegacyTime = run("LegacyValueDelegate", Legacy, LegacySum);
+  double CompactTime = run("ValueDelegate", Compact, CompactSum);
+
+  std::printf("Speedup: %.2fx\n", LegacyTime / CompactTime);
+  return LegacySum == CompactSum ? 0 : 1;
+}
@@ -0,0 +1,373 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ADT_PERSISTENTMAP_H
+#define ICARUS_ADT_PERSISTENTMAP_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace icarus::adt {
+
+/**
+ * Persistent (immutable, structurally shared) map implemented as a hash array mapped trie. Copying an
+ * instance is O(1) as only the root node is shared between both copies. Modifying a copy duplicates
+ * the nodes on the path to the modified entry (at most 13 nodes for a 64-bit hash) and the modified
+ * value itself, while all other nodes and values remain shared between the copies.
+ *
+ * Nodes and values that are exclusively owned by a single map are modified in place. That way, a map
+ * that is never copied behaves like an ordinary (mutable) hash map without the path copying overhead.
+ * Nodes are reference-counted via std::shared_ptr, which makes it safe to modify copies of the same
+ * map in different threads.
+ * @tparam K The type of the keys stored in the map.
+ * @tparam V The type of the values stored in the map. Needs to be copy constructible.
+ * @tparam Hash The hash function for the keys. The result is mixed before it is used in the trie.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>> class PersistentMap {
+
+  static constexpr unsigned BitsPerLevel = 5;
+  static constexpr unsigned MaxShift = 64;
+  static constexpr std::uint64_t LevelMask = (1U << BitsPerLevel) - 1;
+
+  struct Node;
+  using NodePtr = std::shared_ptr<Node>;
+  using ValuePtr = std::shared_ptr<V>;
+
+  struct Entry {
+    std::uint64_t KeyHash;
+    K Key;
+    ValuePtr Value;
+  };
+
+  /**
+   * A single node in the trie. Each node consists of two bitmaps for 32 slots: DataMap marks slots that
+   * directly hold an entry, NodeMap marks slots that hold a child node. The entries and children are
+   * stored compressed in the order of their slot index. Nodes below the maximum depth are collision
+   * nodes and only store entries whose hashes are completely equal.
+   */
+  struct Node {
+    std::uint32_t DataMap = 0;
+    std::uint32_t NodeMap = 0;
+    std::vector<Entry> Entries;
+    std::vector<NodePtr> Children;
+  };
+
+  NodePtr Root;
+  std::size_t Count = 0;
+
+  /**
+   * Mix the bits of the user-provided hash. Hashes of pointers (the most common key type in icarus) are
+   * usually identities with their lowest bits being zero, which would put all of them in the same slot.
+   * @param Key The key to hash.
+   * @return The mixed 64-bit hash of the key.
+   */
+  static std::uint64_t hashKey(const K &Key) {
+    std::uint64_t H = static_cast<std::uint64_t>(Hash()(Key));
+    H ^= H >> 33;
+    H *= 0xff51afd7ed558ccdULL;
+    H ^= H >> 33;
+    H *= 0xc4ceb9fe1a85ec53ULL;
+    H ^= H >> 33;
+    return H;
+  }
+
+  static unsigned slotOf(std::uint64_t KeyHash, unsigned Shift) {
+    return (KeyHash >> Shift) & LevelMask;
+  }
+
+  static unsigned indexOf(std::uint32_t Bitmap, unsigned Slot) {
+    return __builtin_popcount(Bitmap & ((1U << Slot) - 1));
+  }
+
+  /**
+   * Ensures that the node referenced by the provided pointer is exclusively owned by the caller. Nodes
+   * that are shared with other maps are replaced by a shallow copy of the node.
+   * @param N The reference to the node pointer which to make unique.
+   * @return The node that can be modified in place.
+   */
+  static Node &makeUnique(NodePtr &N) {
+    if (N.use_count() != 1)
+      N = std::make_shared<Node>(*N);
+    else
+      std::atomic_thread_fence(std::memory_order_acquire);
+    return *N;
+  }
+
+  /**
+   * Ensures that the value referenced by the provided pointer is exclusively owned by the caller.
+   * @param Value The reference to the value pointer which to make unique.
+   * @return The value that can be modified in place.
+   */
+  static V &makeUnique(ValuePtr &Value) {
+    if (Value.use_count() != 1)
+      Value = std::make_shared<V>(*Value);
+    else
+      std::atomic_thread_fence(std::memory_order_acquire);
+    return *Value;
+  }
+
+  /**
+   * Creates a new node containing two entries whose hashes collide up to the provided shift.
+   */
+  static NodePtr mergeEntries(Entry &&E1, Entry &&E2, unsigned Shift) {
+    NodePtr N = std::make_shared<Node>();
+    if (Shift >= MaxShift) {
+      N->Entries.push_back(std::move(E1));
+      N->Entries.push_back(std::move(E2));
+      return N;
+    }
+
+    unsigned S1 = slotOf(E1.KeyHash, Shift);
+    unsigned S2 = slotOf(E2.KeyHash, Shift);
+    if (S1 == S2) {
+      N->NodeMap = 1U << S1;
+      N->Children.push_back(mergeEntries(std::move(E1), std::move(E2), Shift + BitsPerLevel));
+    } else {
+      N->DataMap = (1U << S1) | (1U << S2);
+      if (S1 > S2)
+        std::swap(E1, E2);
+      N->Entries.push_back(std::move(E1));
+      N->Entries.push_back(std::move(E2));
+    }
+    return N;
+  }
+
+  const Entry *find(const K &Key) const {
+    std::uint64_t KeyHash = hashKey(Key);
+    const Node *N = Root.get();
+    for (unsigned Shift = 0; N; Shift += BitsPerLevel) {
+      if (Shift >= MaxShift) {
+        for (const Entry &E : N->Entries)
+          if (E.Key == Key)
+            return &E;
+        return nullptr;
+      }
+
+      std::uint32_t Bit = 1U << slotOf(KeyHash, Shift);
+      if (N->DataMap & Bit) {
+        const Entry &E = N->Entries[indexOf(N->DataMap, slotOf(KeyHash, Shift))];
+        return E.KeyHash == KeyHash && E.Key == Key ? &E : nullptr;
+      }
+      if (!(N->NodeMap & Bit))
+        return nullptr;
+      N = N->Children[indexOf(N->NodeMap, slotOf(KeyHash, Shift))].get();
+    }
+    return nullptr;
+  }
+
+  /**
+   * Walks down the trie to the entry of the provided key while making all nodes on the path exclusive
+   * to this map. If the entry does not exist and Insert is set, an entry with the provided value is
+   * created and Inserted is set. Returns nullptr, if the entry does not exist and Insert is not set.
+   */
+  Entry *findUnique(const K &Key, const V *Insert, bool &Inserted) {
+    Inserted = false;
+
+    /* Avoid copying nodes on the path if we are not going to modify them */
+    if (!Insert && !find(Key))
+      return nullptr;
+
+    std::uint64_t KeyHash = hashKey(Key);
+    if (!Root)
+      Root = std::make_shared<Node>();
+
+    NodePtr *Current = &Root;
+    for (unsigned Shift = 0;; Shift += BitsPerLevel) {
+      if (Shift >= MaxShift) {
+        Node &N = makeUnique(*Current);
+        for (Entry &E : N.Entries)
+          if (E.Key == Key)
+            return &E;
+        ++Count;
+        Inserted = true;
+        return &N.Entries.emplace_back(Entry{KeyHash, Key, std::make_shared<V>(*Insert)});
+      }
+
+      unsigned Slot = slotOf(KeyHash, Shift);
+      std::uint32_t Bit = 1U << Slot;
+      Node &N = makeUnique(*Current);
+      bool IsData = N.DataMap & Bit;
+      bool IsNode = N.NodeMap & Bit;
+      if (IsNode) {
+        Current = &N.Children[indexOf(N.NodeMap, Slot)];
+        continue;
+      }
+
+      unsigned Index = indexOf(N.DataMap, Slot);
+      if (!IsData) {
+        N.DataMap |= Bit;
+        ++Count;
+        Inserted = true;
+        return &*N.Entries.insert(N.Entries.begin() + Index, Entry{KeyHash, Key, std::make_shared<V>(*Insert)});
+      }
+
+      Entry &E = N.Entries[Index];
+      if (E.KeyHash == KeyHash && E.Key == Key)
+        return &E;
+
+      /* Two different keys in the same slot, push both of them down one level */
+      Entry Existing = std::move(E);
+      N.Entries.erase(N.Entries.begin() + Index);
+      N.DataMap &= ~Bit;
+      N.NodeMap |= Bit;
+      unsigned ChildIndex = indexOf(N.NodeMap, Slot);
+      N.Children.insert(N.Children.begin() + ChildIndex,
+                        mergeEntries(std::move(Existing), Entry{KeyHash, Key, std::make_shared<V>(*Insert)},
+                                     Shift + BitsPerLevel));
+      ++Count;
+      Inserted = true;
+      return const_cast<Entry *>(find(Key));
+    }
+  }
+
+  /**
+   * Removes the entry of the provided key, which has to exist in the subtrie of the provided node. Nodes
+   * that become empty after the removal are removed from their parent node.
+   */
+  static void eraseFrom(NodePtr &Current, const K &Key, std::uint64_t KeyHash, unsigned Shift) {
+    Node &N = makeUnique(Current);
+    if (Shift >= MaxShift) {
+      for (auto I = N.Entries.begin(); I != N.Entries.end(); ++I) {
+        if (I->Key == Key) {
+          N.Entries.erase(I);
+          return;
+        }
+      }
+      return;
+    }
+
+    unsigned Slot = slotOf(KeyHash, Shift);
+    std::uint32_t Bit = 1U << Slot;
+    if (N.DataMap & Bit) {
+      N.Entries.erase(N.Entries.begin() + indexOf(N.DataMap, Slot));
+      N.DataMap &= ~Bit;
+      return;
+    }
+
+    unsigned Index = indexOf(N.NodeMap, Slot);
+    eraseFrom(N.Children[Index], Key, KeyHash, Shift + BitsPerLevel);
+    const Node &Child = *N.Children[Index];
+    if (Child.Entries.empty() && Child.Children.empty()) {
+      N.Children.erase(N.Children.begin() + Index);
+      N.NodeMap &= ~Bit;
+    }
+  }
+
+  template <typename Func> static void forEachIn(const Node *N, Func &Function) {
+    if (!N)
+      return;
+    for (const Entry &E : N->Entries)
+      Function(E.Key, static_cast<const V &>(*E.Value));
+    for (const NodePtr &Child : N->Children)
+      forEachIn(Child.get(), Function);
+  }
+
+public:
+  PersistentMap() = default;
+
+  /**
+   * @return The number of entries in this map.
+   */
+  std::size_t size() const {
+    return Count;
+  }
+
+  bool empty() const {
+    return !Count;
+  }
+
+  bool contains(const K &Key) const {
+    return find(Key) != nullptr;
+  }
+
+  /**
+   * Look up the value associated with the provided key without modifying the map.
+   * @param Key The key to look up.
+   * @return A pointer to the value or nullptr, if the key does not exist in this map.
+   */
+  const V *lookup(const K &Key) const {
+    const Entry *E = find(Key);
+    return E ? E->Value.get() : nullptr;
+  }
+
+  /**
+   * Look up the value associated with the provided key for modification. If the value is shared with a
+   * copy of this map, it is copied before the pointer to it is returned (copy-on-write).
+   * @param Key The key to look up.
+   * @return A pointer to the modifiable value or nullptr, if the key does not exist in this map.
+   */
+  V *lookupMutable(const K &Key) {
+    bool Inserted;
+    Entry *E = findUnique(Key, nullptr, Inserted);
+    return E ? &makeUnique(E->Value) : nullptr;
+  }
+
+  /**
+   * Returns the value associated with the key for modification. The value is inserted if the key does
+   * not exist in this map, otherwise it is copied if shared with another map (copy-on-write).
+   * @param Key The key to look up or insert.
+   * @param Default The value to insert if the key does not exist yet.
+   * @return A reference to the modifiable value.
+   */
+  V &getOrInsert(const K &Key, const V &Default = V()) {
+    bool Inserted;
+    return makeUnique(findUnique(Key, &Default, Inserted)->Value);
+  }
+
+  /**
+   * Associates the key with the provided value. Existing values are replaced, but not modified, as they
+   * might still be in use by other copies of this map.
+   * @param Key The key of the value.
+   * @param Value The value to associate with the key.
+   */
+  void insert(const K &Key, const V &Value) {
+    bool Inserted;
+    Entry *E = findUnique(Key, &Value, Inserted);
+    if (!Inserted)
+      E->Value = std::make_shared<V>(Value);
+  }
+
+  /**
+   * Removes the provided key from this map.
+   * @param Key The key to remove.
+   * @return True, if the key was contained in this map.
+   */
+  bool erase(const K &Key) {
+    if (!contains(Key))
+      return false;
+    eraseFrom(Root, Key, hashKey(Key), 0);
+    --Count;
+    return true;
+  }
+
+  void clear() {
+    Root.reset();
+    Count = 0;
+  }
+
+  /**
+   * Calls the provided function for each key-value pair in this map. The iteration order depends on the
+   * hashes of the keys and is not related to the insertion order.
+   * @tparam Func The type of the function to call, accepting a key and a value.
+   * @param Function The function to call for each entry.
+   */
+  template <typename Func> void forEach(Func &&Function) const {
+    forEachIn(Root.get(), Function);
+  }
+
+  /**
+   * @param Other The map to compare against.
+   * @return True, if both maps share the same root, i.e. none of them was modified since copying.
+   */
+  bool sharesRootWith(const PersistentMap &Other) const {
+    return Root == Other.Root;
+  }
+};
+
+} // namespace icarus::adt
+
+#endif // ICARUS_ADT_PERSISTENTMAP_H
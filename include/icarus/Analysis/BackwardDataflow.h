@@ -0,0 +1,168 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_BACKWARDDATAFLOW_H
+#define ICARUS_ANALYSIS_BACKWARDDATAFLOW_H
+
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/PostOrderIterator.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/Module.h>
+
+#include <icarus/Threads/TaskGroup.h>
+
+#include <atomic>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Solver for backward dataflow problems on the CFG of a single function. The problem is described by an
+ * analysis class, which provides the following members:
+ *
+ *   using DomainT = ...;
+ *   DomainT getInitial(llvm::BasicBlock &BB);
+ *     The initial state at the start of the block (i.e. the bottom element of the lattice).
+ *   DomainT getBoundary(llvm::BasicBlock &Exit);
+ *     The state at the end of a block without successors (e.g. a return or unreachable instruction).
+ *   void meet(DomainT &Out, llvm::BasicBlock &BB, llvm::BasicBlock &Succ, const DomainT &SuccIn);
+ *     Merge the state at the start of a successor into the state at the end of the block.
+ *   bool transfer(llvm::BasicBlock &BB, const DomainT &Out, DomainT &In);
+ *     Compute the state at the start of the block, return true if the state changed.
+ *
+ * Functions may have any number of exit blocks, each of them starts with its own boundary state. Blocks
+ * are iterated in post-order of the CFG, so that successors are usually visited before predecessors (for
+ * reducible CFGs this is the reverse post-order of the reverse CFG). Pending blocks are tracked in a bit
+ * vector indexed by their position in this order, and the solver always continues with the first pending
+ * block. Blocks unreachable from the entry block are not analyzed.
+ * @tparam Analysis The class describing the dataflow problem.
+ */
+template <typename Analysis> class BackwardDataflow {
+
+public:
+  using DomainT = typename Analysis::DomainT;
+
+private:
+  Analysis &A;
+  std::vector<llvm::BasicBlock *> Order;
+  llvm::DenseMap<const llvm::BasicBlock *, unsigned> Positions;
+  std::vector<DomainT> In;
+  std::vector<DomainT> Out;
+  unsigned NumTransfers = 0;
+
+public:
+  /**
+   * Prepare the solver for the provided function. The function must not be a declaration.
+   * @param A The analysis describing the dataflow problem.
+   * @param F The function to analyze.
+   */
+  BackwardDataflow(Analysis &A, llvm::Function &F) : A(A) {
+    for (llvm::BasicBlock *BB : llvm::post_order(&F.getEntryBlock())) {
+      Positions[BB] = Order.size();
+      Order.push_back(BB);
+    }
+    for (llvm::BasicBlock *BB : Order) {
+      In.push_back(A.getInitial(*BB));
+      Out.push_back(A.getInitial(*BB));
+    }
+  }
+
+  /**
+   * Compute the fixpoint of the dataflow problem.
+   * @return The number of evaluated transfer functions.
+   */
+  unsigned solve() {
+    llvm::BitVector Pending(Order.size(), true);
+    for (int N = Pending.find_first(); N != -1; N = Pending.find_first()) {
+      Pending.reset(N);
+      llvm::BasicBlock *BB = Order[N];
+
+      bool IsExit = true;
+      DomainT &BlockOut = Out[N];
+      for (llvm::BasicBlock *Succ : llvm::successors(BB)) {
+        if (IsExit)
+          BlockOut = A.getInitial(*BB);
+        IsExit = false;
+        A.meet(BlockOut, *BB, *Succ, In[Positions.lookup(Succ)]);
+      }
+      if (IsExit)
+        BlockOut = A.getBoundary(*BB);
+
+      ++NumTransfers;
+      if (!A.transfer(*BB, BlockOut, In[N]))
+        continue;
+
+      for (llvm::BasicBlock *Pred : llvm::predecessors(BB)) {
+        auto It = Positions.find(Pred);
+        if (It != Positions.end())
+          Pending.set(It->second);
+      }
+    }
+    return NumTransfers;
+  }
+
+  bool isReachable(const llvm::BasicBlock &BB) const {
+    return Positions.count(&BB);
+  }
+
+  /**
+   * @param BB A basic block reachable from the entry block.
+   * @return The state at the start of the basic block.
+   */
+  const DomainT &getIn(const llvm::BasicBlock &BB) const {
+    return In[Positions.lookup(&BB)];
+  }
+
+  /**
+   * @param BB A basic block reachable from the entry block.
+   * @return The state at the end of the basic block.
+   */
+  const DomainT &getOut(const llvm::BasicBlock &BB) const {
+    return Out[Positions.lookup(&BB)];
+  }
+
+  unsigned getNumTransfers() const {
+    return NumTransfers;
+  }
+};
+
+/**
+ * Solve a backward dataflow problem for all defined functions of the module. The functions are analyzed
+ * in parallel by all threads of the thread pool and the current thread, each function by a single thread.
+ * @tparam Factory The type of the callable creating the analysis for a function.
+ * @tparam Consumer The type of the callable receiving the solution for a function.
+ * @param M The module whose functions to analyze.
+ * @param CreateAnalysis The callable returning the analysis for the provided llvm::Function reference.
+ * @param Consume The callable which is called with the function, its analysis and the solved dataflow
+ *                problem (BackwardDataflow). Called concurrently for different functions.
+ */
+template <typename Factory, typename Consumer>
+void solveBackwardDataflow(llvm::Module &M, Factory &&CreateAnalysis, Consumer &&Consume) {
+  std::vector<llvm::Function *> Functions;
+  for (llvm::Function &F : M)
+    if (!F.isDeclaration())
+      Functions.push_back(&F);
+
+  std::atomic<std::size_t> NextFunction = 0;
+  auto Worker = [&]() {
+    for (std::size_t N = NextFunction++; N < Functions.size(); N = NextFunction++) {
+      llvm::Function &F = *Functions[N];
+      auto A = CreateAnalysis(F);
+      BackwardDataflow<decltype(A)> Dataflow(A, F);
+      Dataflow.solve();
+      Consume(F, A, Dataflow);
+    }
+  };
+
+  TaskGroup Workers;
+  for (unsigned N = 0; N < ThreadPool::getCurrentThreadNum() && N + 1 < Functions.size(); ++N)
+    Workers.run(Worker);
+  Worker();
+  Workers.wait();
+}
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_BACKWARDDATAFLOW_H
@@ -0,0 +1,133 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_CALLGRAPH_H
+#define ICARUS_ANALYSIS_CALLGRAPH_H
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/StringMap.h>
+#include <llvm/IR/Module.h>
+
+#include <icarus/Threads/TaskGroup.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Call graph of the defined functions of multiple modules, condensed into its strongly connected
+ * components (SCCs). Calls to declarations are resolved to the definition with the same name in any
+ * of the modules, so that calls between modules (e.g. between the object files of a kernel) are part
+ * of the call graph. Indirect calls are not resolved.
+ *
+ * The SCCs are numbered bottom-up: Each SCC has a greater index than all SCCs it calls.
+ */
+class CallGraphSCCs {
+
+public:
+  struct SCC {
+    unsigned Index;
+    std::vector<llvm::Function *> Functions;
+
+    /* Indices of the SCCs called from or calling this SCC (excluding itself) */
+    std::vector<unsigned> Callees;
+    std::vector<unsigned> Callers;
+
+    /* True, if a function of this SCC calls a function of the same SCC (including itself) */
+    bool Recursive = false;
+
+    /* True, if the SCC is part of a longest chain of calls, which determines the length of a bottom-up schedule */
+    bool Critical = false;
+  };
+
+private:
+  llvm::StringMap<llvm::Function *> Definitions;
+  llvm::DenseMap<const llvm::Function *, unsigned> FunctionSCCs;
+  std::vector<SCC> SCCs;
+
+  void computeSCCs(const std::vector<llvm::Function *> &Functions,
+                   const std::vector<std::vector<unsigned>> &Successors);
+
+  void computeCriticalPath();
+
+public:
+  /**
+   * Build the call graph of all defined functions of the provided modules and compute its SCCs.
+   * @param Modules The modules to analyze.
+   */
+  explicit CallGraphSCCs(llvm::ArrayRef<llvm::Module *> Modules);
+
+  /**
+   * @param F A function of one of the modules.
+   * @return The definition of the function in any of the modules, or nullptr if it is not defined.
+   */
+  llvm::Function *resolve(llvm::Function *F) const;
+
+  /**
+   * @param F A defined function of one of the modules.
+   * @return The SCC containing the definition of the function, or nullptr if it is not defined.
+   */
+  const SCC *getSCC(llvm::Function *F) const;
+
+  unsigned size() const {
+    return SCCs.size();
+  }
+
+  const SCC &operator[](unsigned N) const {
+    return SCCs[N];
+  }
+
+  std::vector<SCC>::const_iterator begin() const {
+    return SCCs.begin();
+  }
+
+  std::vector<SCC>::const_iterator end() const {
+    return SCCs.end();
+  }
+
+  /**
+   * Call the provided function for all SCCs in bottom-up order: The function is called for an SCC only
+   * after it returned for all SCCs called by it. The SCCs are scheduled as tasks of the current pool once
+   * all of their callees are done, so that independent parts of the call graph are processed in parallel.
+   * SCCs on the critical path are scheduled with high priority, since all of their callers wait for them.
+   * Without threads in the pool, the SCCs are processed in the current thread in the order of their index.
+   * @tparam Func The type of the callable receiving a const SCC reference.
+   * @param Summarize The function computing the summary of an SCC. Called concurrently for different SCCs.
+   */
+  template <typename Func> void runBottomUp(Func &&Summarize) const {
+    if (!ThreadPool::getCurrentThreadNum()) {
+      for (const SCC &C : SCCs)
+        Summarize(C);
+      return;
+    }
+
+    std::vector<std::atomic<unsigned>> Pending(SCCs.size());
+    for (const SCC &C : SCCs)
+      Pending[C.Index] = C.Callees.size();
+
+    TaskGroup Group;
+    std::function<void(unsigned)> Run;
+    auto Schedule = [&](unsigned N) {
+      Group.runWithPriority(SCCs[N].Critical ? TaskPriority::High : TaskPriority::Normal, [&Run, N]() { Run(N); });
+    };
+    Run = [&](unsigned N) {
+      Summarize(SCCs[N]);
+      for (unsigned Caller : SCCs[N].Callers)
+        if (--Pending[Caller] == 0)
+          Schedule(Caller);
+    };
+
+    for (const SCC &C : SCCs)
+      if (C.Callees.empty())
+        Schedule(C.Index);
+    Group.wait();
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_CALLGRAPH_H
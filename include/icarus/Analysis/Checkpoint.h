@@ -0,0 +1,106 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_CHECKPOINT_H
+#define ICARUS_ANALYSIS_CHECKPOINT_H
+
+#include <llvm/ADT/StringRef.h>
+
+#include <icarus/Analysis/ContextSerializer.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Periodic checkpoints of the pending program contexts of an analysis. Long-running analyses write the
+ * contexts of their worker queues into a checkpoint file in regular intervals, so that an interrupted
+ * run can be resumed from the last checkpoint instead of restarting from the entry points.
+ *
+ * A checkpoint file contains a header with the fingerprint of the analyzed modules, followed by the
+ * serialized program contexts (see icarus::ContextWriter). The file is written to a temporary file
+ * first and renamed afterwards, so that a crash during the write does not destroy the last checkpoint.
+ */
+class Checkpointer {
+
+  const ModuleIndex &Index;
+  std::string Path;
+  std::chrono::seconds Interval;
+
+  /* Time of the last checkpoint in ticks of std::chrono::steady_clock, checked by all workers */
+  std::atomic<std::chrono::steady_clock::rep> LastCheckpoint;
+
+public:
+  /**
+   * @param Index The index of the analyzed modules.
+   * @param Path The path of the checkpoint file, an empty path disables checkpoints.
+   * @param Interval The minimum time between two checkpoints.
+   */
+  Checkpointer(const ModuleIndex &Index, llvm::StringRef Path, std::chrono::seconds Interval);
+
+  bool isEnabled() const;
+
+  /**
+   * @return True, if checkpoints are enabled and the interval since the last checkpoint has passed.
+   */
+  bool isDue() const;
+
+  /**
+   * Write the provided serialized program contexts into the checkpoint file.
+   * @param States The serialized program contexts.
+   * @return True, if the checkpoint has been written successfully.
+   */
+  bool write(llvm::ArrayRef<std::string> States);
+
+  /**
+   * Read the serialized program contexts from the checkpoint file.
+   * @param States The vector to append the serialized program contexts to.
+   * @return True, if the checkpoint exists and belongs to the analyzed modules.
+   */
+  bool read(std::vector<std::string> &States) const;
+
+  /**
+   * Serialize and write the provided program contexts into the checkpoint file.
+   * @tparam Range The type of the range of ProgramContext instances.
+   * @param Contexts The pending program contexts of the analysis.
+   * @return True, if the checkpoint has been written successfully. Contexts which could not be restored are
+   *         not written, the previous checkpoint (if any) is kept in this case.
+   */
+  template <typename Range> bool save(const Range &Contexts) {
+    std::vector<std::string> States;
+    for (const auto &PC : Contexts) {
+      ContextWriter Writer(Index);
+      Writer.writeProgramContext(PC);
+      if (Writer.hasFailed())
+        return false;
+      States.push_back(Writer.takeBuffer());
+    }
+    return write(States);
+  }
+
+  /**
+   * Restore the program contexts from the checkpoint file.
+   * @tparam AnalysisIterator The instruction iterator of the program contexts.
+   * @param Contexts The vector to append the restored program contexts to.
+   * @return True, if all program contexts have been restored successfully.
+   */
+  template <typename AnalysisIterator> bool restore(std::vector<ProgramContext<AnalysisIterator>> &Contexts) const {
+    std::vector<std::string> States;
+    if (!read(States))
+      return false;
+    for (const std::string &State : States) {
+      ContextReader Reader(Index, State);
+      if (!Reader.readProgramContext(Contexts.emplace_back()) || !Reader.atEnd())
+        return false;
+    }
+    return true;
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_CHECKPOINT_H
@@ -0,0 +1,355 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_CONTEXTSERIALIZER_H
+#define ICARUS_ANALYSIS_CONTEXTSERIALIZER_H
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/IR/Module.h>
+
+#include <icarus/Analysis/ProgramContext.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Stable numbering of the IR values of a list of modules. Serialized program states refer to values by
+ * their position in the analyzed modules instead of their addresses, so that a state can be restored in
+ * a different process as long as the same modules are loaded in the same order.
+ *
+ * Values are encoded as a kind followed by a sequence of indices:
+ *
+ *  - Global variables and functions by their module and their position in the module.
+ *  - Arguments and instructions by their function and their slot (see icarus::FunctionSlots).
+ *  - Basic blocks by their function and their position in the function.
+ *  - Constants by an instruction using them and the operand number of the use.
+ *
+ * Constants which are not used by any instruction in the modules cannot be encoded.
+ */
+class ModuleIndex {
+
+  std::vector<llvm::Module *> Modules;
+  std::vector<std::vector<llvm::GlobalVariable *>> Globals;
+  std::vector<std::vector<llvm::Function *>> Functions;
+
+  /* Module and position of all global variables, functions and basic blocks */
+  llvm::DenseMap<const llvm::Value *, std::pair<unsigned, unsigned>> Positions;
+
+  /* Basic blocks of all functions, indexed by the position of the function */
+  llvm::DenseMap<const llvm::Function *, std::vector<llvm::BasicBlock *>> Blocks;
+
+public:
+  enum ValueKind : unsigned { VK_Null, VK_Global, VK_Function, VK_Local, VK_Block, VK_Constant };
+
+  explicit ModuleIndex(llvm::ArrayRef<llvm::Module *> Modules);
+
+  /**
+   * @return A fingerprint of the indexed modules, used to reject checkpoints of different programs.
+   */
+  uint64_t getFingerprint() const;
+
+  /**
+   * Encode the provided value as a kind followed by its indices.
+   * @param V The value to encode.
+   * @param Indices The vector to append the kind and indices to.
+   * @return True, if the value could be encoded. Otherwise, VK_Null is appended.
+   */
+  bool encode(const llvm::Value *V, std::vector<uint64_t> &Indices) const;
+
+  /**
+   * Decode the value from the provided kind and indices.
+   * @param Indices The kind and the indices of the value, advanced past the decoded value.
+   * @param V The decoded value, nullptr for VK_Null.
+   * @return True, if the indices referred to a valid value.
+   */
+  bool decode(llvm::ArrayRef<uint64_t> &Indices, llvm::Value *&V) const;
+
+  /**
+   * @param Kind The kind of the value.
+   * @return The number of indices following the kind.
+   */
+  static unsigned getNumIndices(unsigned Kind);
+};
+
+/**
+ * Writer for the compact binary encoding of program states. Integers are written as unsigned LEB128
+ * variable-length integers, so that the small indices and offsets dominating the states take a single
+ * byte in most cases.
+ *
+ * The writer fails on program states which ContextReader could not restore, i.e. memory regions whose
+ * base cannot be encoded and delegates pointing to regions which are not written. The buffer of a failed
+ * writer must not be used.
+ */
+class ContextWriter {
+
+  const ModuleIndex &Index;
+  std::string Buffer;
+  bool Failed = false;
+
+  /* Bases of the regions written by ContextWriter::writeProgramContext */
+  llvm::DenseSet<const llvm::Value *> Regions;
+
+public:
+  explicit ContextWriter(const ModuleIndex &Index) : Index(Index) {}
+
+  const std::string &getBuffer() const;
+  std::string takeBuffer();
+  bool hasFailed() const;
+
+  void writeVarint(uint64_t Value);
+  void writeString(llvm::StringRef String);
+  void writeValue(const llvm::Value *V);
+
+  /**
+   * Write a delegate. Delegates pointing to memory regions can only be written by
+   * ContextWriter::writeProgramContext, after the region itself has been written.
+   * @param Delegate The delegate to write.
+   */
+  void writeDelegate(const ValueDelegate &Delegate);
+
+  /**
+   * Serialize the memory, the named and addressable values and the call stack of the program context.
+   * The writer fails if a memory region cannot be encoded, see ContextWriter::hasFailed.
+   * @param PC The program context to serialize.
+   */
+  template <typename AnalysisIterator> void writeProgramContext(const ProgramContext<AnalysisIterator> &PC);
+
+  /**
+   * Serialize the current position and the values of a call frame.
+   * @param FC The call frame to serialize.
+   */
+  template <typename AnalysisIterator> void writeFunctionContext(const FunctionContext<AnalysisIterator> &FC);
+};
+
+/**
+ * Reader for the binary encoding produced by ContextWriter. The reader fails on truncated input or on
+ * values which do not exist in the indexed modules, after which all subsequent reads fail as well.
+ */
+class ContextReader {
+
+  const ModuleIndex &Index;
+  llvm::StringRef Data;
+  std::size_t Pos = 0;
+  bool Failed = false;
+
+  /**
+   * Mark the reader as failed.
+   * @return Always false.
+   */
+  bool fail();
+
+public:
+  ContextReader(const ModuleIndex &Index, llvm::StringRef Data) : Index(Index), Data(Data) {}
+
+  bool hasFailed() const;
+  bool atEnd() const;
+
+  bool readVarint(uint64_t &Value);
+  bool readString(std::string &String);
+  bool readValue(llvm::Value *&V);
+
+  /**
+   * Read a delegate. Delegates pointing to memory regions are resolved in the provided context, so all
+   * regions have to be allocated before their delegates are read.
+   * @param PC The context containing the memory regions.
+   * @param Delegate The read delegate.
+   * @return True, if the delegate was read successfully.
+   */
+  template <typename AnalysisIterator> bool readDelegate(ProgramContext<AnalysisIterator> &PC, ValueDelegate &Delegate);
+
+  /**
+   * Restore the program context serialized by ContextWriter::writeProgramContext.
+   * @param PC The empty program context to restore into.
+   * @return True, if the program context was read successfully.
+   */
+  template <typename AnalysisIterator> bool readProgramContext(ProgramContext<AnalysisIterator> &PC);
+};
+
+/*
+ * ContextWriter template methods
+ */
+
+template <typename AnalysisIterator>
+void ContextWriter::writeProgramContext(const ProgramContext<AnalysisIterator> &PC) {
+  std::vector<std::pair<std::string, llvm::Value *>> Named;
+  PC.forEachNamedValue([&](const std::string &Name, llvm::Value *V) { Named.emplace_back(Name, V); });
+  writeVarint(Named.size());
+  for (const auto &[Name, V] : Named) {
+    writeString(Name);
+    writeValue(V);
+  }
+
+  std::vector<std::pair<uint64_t, llvm::Value *>> Addressable;
+  PC.forEachAddressableValue([&](uint64_t Address, llvm::Value *V) { Addressable.emplace_back(Address, V); });
+  writeVarint(Addressable.size());
+  for (const auto &[Address, V] : Addressable) {
+    writeVarint(Address);
+    writeValue(V);
+  }
+
+  /* Regions are written in two passes, as fragments may point to regions which are written later */
+  std::vector<const EngineValue *> Written;
+  std::vector<uint64_t> Indices;
+  PC.forEachEngineValue([&](llvm::Value *Base, const EngineValue &EV) {
+    Indices.clear();
+    if (!Index.encode(Base, Indices)) {
+      Failed = true;
+      return;
+    }
+    Written.push_back(&EV);
+    Regions.insert(Base);
+  });
+
+  writeVarint(Written.size());
+  for (const EngineValue *EV : Written) {
+    writeValue(EV->getBase());
+    writeVarint(EV->getSize());
+  }
+
+  for (const EngineValue *EV : Written) {
+    writeVarint(EV->getNumFragments());
+    EV->forEachFragment([&](uint64_t Offset, const EngineValue::Fragment &F) {
+      writeVarint(Offset);
+      writeVarint(F.Size);
+      writeDelegate(F.Delegate);
+    });
+  }
+
+  writeVarint(PC.getStackDepth());
+  for (std::size_t N = 0; N < PC.getStackDepth(); ++N)
+    writeFunctionContext(PC.getFunctionContext(N));
+  Regions.clear();
+}
+
+template <typename AnalysisIterator>
+void ContextWriter::writeFunctionContext(const FunctionContext<AnalysisIterator> &FC) {
+  writeValue(FC.getFunction());
+  writeValue(FC.getCaller());
+  writeValue(FC.getBlock());
+  writeVarint(FC.getPosition());
+
+  unsigned NumSlots = FC.getSlots().getNumSlots();
+  writeVarint(NumSlots);
+  for (unsigned Slot = 0; Slot < NumSlots; ++Slot)
+    writeDelegate(FC.getValue(Slot));
+}
+
+/*
+ * ContextReader template methods
+ */
+
+template <typename AnalysisIterator>
+bool ContextReader::readDelegate(ProgramContext<AnalysisIterator> &PC, ValueDelegate &Delegate) {
+  uint64_t Tag;
+  if (!readVarint(Tag))
+    return false;
+
+  llvm::Value *V = nullptr;
+  uint64_t Offset = 0;
+  switch (Tag) {
+  case 0:
+    Delegate = ValueDelegate();
+    return true;
+  case 1:
+    if (!readValue(V))
+      return false;
+    Delegate = ValueDelegate(V);
+    return true;
+  case 2:
+    if (!readValue(V) || !readVarint(Offset))
+      return false;
+    if (const EngineValue *EV = PC.getEngineValue(V)) {
+      Delegate = ValueDelegate(EV, Offset);
+      return true;
+    }
+    return fail();
+  default:
+    return fail();
+  }
+}
+
+template <typename AnalysisIterator> bool ContextReader::readProgramContext(ProgramContext<AnalysisIterator> &PC) {
+  uint64_t Count;
+  if (!readVarint(Count))
+    return false;
+  for (uint64_t N = 0; N < Count; ++N) {
+    std::string Name;
+    llvm::Value *V;
+    if (!readString(Name) || !readValue(V))
+      return false;
+    PC.setNamedValue(Name, V);
+  }
+
+  if (!readVarint(Count))
+    return false;
+  for (uint64_t N = 0; N < Count; ++N) {
+    uint64_t Address;
+    llvm::Value *V;
+    if (!readVarint(Address) || !readValue(V))
+      return false;
+    PC.setAddressableValue(Address, V);
+  }
+
+  if (!readVarint(Count))
+    return false;
+  std::vector<llvm::Value *> Bases(Count);
+  for (llvm::Value *&Base : Bases) {
+    uint64_t Size;
+    if (!readValue(Base) || !readVarint(Size) || !Base)
+      return fail();
+    PC.allocateEngineValue(Base, Size);
+  }
+
+  for (llvm::Value *Base : Bases) {
+    EngineValue *EV = PC.getMutableEngineValue(Base);
+    uint64_t NumFragments;
+    if (!readVarint(NumFragments))
+      return false;
+    for (uint64_t N = 0; N < NumFragments; ++N) {
+      uint64_t Offset, Size;
+      ValueDelegate Delegate;
+      if (!readVarint(Offset) || !readVarint(Size) || !readDelegate(PC, Delegate))
+        return false;
+      if (!EV->store(Offset, Size, Delegate))
+        return false;
+    }
+  }
+
+  if (!readVarint(Count))
+    return false;
+  for (uint64_t N = 0; N < Count; ++N) {
+    llvm::Value *F, *Caller, *BB;
+    uint64_t Position, NumSlots;
+    if (!readValue(F) || !readValue(Caller) || !readValue(BB) || !readVarint(Position) || !readVarint(NumSlots))
+      return false;
+    if (!F || !llvm::isa<llvm::Function>(F) || (Caller && !llvm::isa<llvm::CallInst>(Caller)))
+      return fail();
+    if (BB && (!llvm::isa<llvm::BasicBlock>(BB) || llvm::cast<llvm::BasicBlock>(BB)->getParent() != F ||
+               Position > llvm::cast<llvm::BasicBlock>(BB)->size()))
+      return fail();
+
+    auto &FC = PC.pushFunctionContext(*llvm::cast<llvm::Function>(F), llvm::cast_or_null<llvm::CallInst>(Caller));
+    if (NumSlots != FC.getSlots().getNumSlots())
+      return fail();
+    FC.setPosition(llvm::cast_or_null<llvm::BasicBlock>(BB), Position);
+    for (unsigned Slot = 0; Slot < NumSlots; ++Slot) {
+      ValueDelegate Delegate;
+      if (!readDelegate(PC, Delegate))
+        return false;
+      FC.setValue(Slot, Delegate);
+    }
+  }
+
+  return !Failed;
+}
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_CONTEXTSERIALIZER_H
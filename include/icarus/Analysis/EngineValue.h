@@ -5,9 +5,14 @@
 #ifndef ICARUS_ANALYSIS_ENGINEVALUE_H
 #define ICARUS_ANALYSIS_ENGINEVALUE_H
 
+#include <llvm/ADT/Hashing.h>
+#include <llvm/IR/DataLayout.h>
 #include <llvm/IR/Value.h>
 
+#include <cassert>
+#include <cstdint>
 #include <map>
+#include <type_traits>
 
 namespace icarus {
 
@@ -17,56 +22,286 @@ class EngineValue;
  * Class representing an arbitrary value in memory. The purpose of the class is to store and propagate
  * values an instruction may contain during the analysis of a program. It is similar to LLVMs in-house
  * llvm::GenericValue class, except that we use a pointer to a llvm::Value directly.
+ *
+ * Delegates are stored in large numbers in every EngineValue and call frame, which is why the class is
+ * a single tagged pointer word. The two lowest bits of the word select the represented value:
+ *
+ *  - TagValue:  The word is a pointer to a llvm::Value. The null pointer represents an invalid value.
+ *  - TagNode:   The word is a pointer to the base of a node, with the offset into the node packed into the
+ *               upper (unused) bits of the pointer. Only applicable for small offsets.
+ *  - TagRecord: The word is a pointer to an interned OffsetRecord, which stores the base and the offset
+ *               out of line. Used for offsets that do not fit into the upper bits of the pointer.
+ *
+ * Delegates pointing to a node store the base of the node instead of the address of the EngineValue. The
+ * EngineValue is copied when a forked ProgramContext modifies it and freed with the last context holding
+ * it, whereas the base remains valid for the entire analysis. Node delegates are therefore resolved in a
+ * ProgramContext (see ProgramContext::getDelegate).
+ *
+ * The class is trivially copyable, which allows copying arrays of delegates with memcpy.
  */
 class ValueDelegate {
 
-  uint64_t isNode : 1;
-  uint64_t Offset : 63;
-
-  union {
-    EngineValue *Node;
-    llvm::Value *CVal;
+  /**
+   * Out-of-line storage for delegates pointing to a node with an offset that cannot be packed into the
+   * pointer itself. Records are interned and never freed, so that delegates remain trivially copyable.
+   * As they are keyed by the base and the offset, all copies of a region share their records, and their
+   * number is bounded by the distinct offsets used for the bases of the module.
+   */
+  struct OffsetRecord {
+    llvm::Value *Base;
+    uint64_t Offset;
   };
 
-public:
-  ValueDelegate() : isNode(false), Offset(0) {}
+  static constexpr uintptr_t TagValue = 0;
+  static constexpr uintptr_t TagNode = 1;
+  static constexpr uintptr_t TagRecord = 2;
+  static constexpr uintptr_t TagMask = 3;
+
+  /* Number of bits of the pointer which hold the offset on 64-bit platforms */
+  static constexpr unsigned OffsetBits = sizeof(uintptr_t) == 8 ? 16 : 0;
+  static constexpr unsigned PointerBits = sizeof(uintptr_t) * 8 - OffsetBits;
+  static constexpr uintptr_t PointerMask = (~uintptr_t(0) >> OffsetBits) & ~TagMask;
 
-  ValueDelegate(EngineValue *Node, uint64_t Offset = 0) : isNode(true), Offset(Offset), Node(Node) {}
+  uintptr_t Bits;
 
-  ValueDelegate(llvm::Value *CVal) : isNode(false), Offset(0), CVal(CVal) {}
+  uintptr_t getTag() const {
+    return Bits & TagMask;
+  }
 
-  ValueDelegate(const ValueDelegate &Other) : isNode(Other.isNode), Offset(Other.Offset) {
-    if (isNodeDelegate())
-      Node = Other.Node;
-    else
-      CVal = Other.CVal;
+  const OffsetRecord *getRecord() const {
+    return reinterpret_cast<const OffsetRecord *>(Bits & ~TagMask);
   }
 
+  /**
+   * Returns the interned record for the provided base and offset.
+   */
+  static const OffsetRecord *getOffsetRecord(llvm::Value *Base, uint64_t Offset);
+
+public:
+  ValueDelegate() : Bits(0) {}
+
+  /**
+   * Create a delegate pointing to the provided offset in a node. Only the base of the node is stored.
+   * @param Node The node to point to, which has to have a base.
+   * @param Offset The offset into the node.
+   */
+  ValueDelegate(const EngineValue *Node, uint64_t Offset = 0);
+
+  ValueDelegate(llvm::Value *CVal) : Bits(reinterpret_cast<uintptr_t>(CVal)) {}
+
   /**
    * Method which checks if the delegate represents a valid value. An instance that was created by the
    * default constructor is invalid since it neither represents a node or a pointer to a node. We will
    * use invalid nodes to identify values whose content is not uniquely determinable.
    * @return True, if the value is uniquely determinable.
    */
-  bool isValid() const;
+  bool isValid() const {
+    return Bits != 0;
+  }
+
+  bool isNodeDelegate() const {
+    return getTag() != TagValue;
+  }
+
+  /**
+   * @return The base of the node this delegate points to.
+   */
+  llvm::Value *getBase() const {
+    assert((isNodeDelegate()));
+    if (getTag() == TagRecord)
+      return getRecord()->Base;
+    return reinterpret_cast<llvm::Value *>(Bits & PointerMask);
+  }
+
+  llvm::Value *getValue() const {
+    assert((!isNodeDelegate()));
+    return reinterpret_cast<llvm::Value *>(Bits);
+  }
+
+  uint64_t getOffset() const {
+    if (getTag() == TagRecord)
+      return getRecord()->Offset;
+    return getTag() == TagNode && OffsetBits ? Bits >> PointerBits : 0;
+  }
+
+  /**
+   * Returns the identity of the value this delegate represents. For delegates pointing to a node, this
+   * is the base of the node, so that delegates to the same memory region in forked program contexts
+   * are considered equal. For all other delegates, this is the llvm::Value itself.
+   * @return The pointer identifying the represented value, or nullptr for invalid delegates.
+   */
+  const void *getIdentity() const;
+
+  bool operator==(const ValueDelegate &Other) const;
+  bool operator!=(const ValueDelegate &Other) const;
 
-  bool isNodeDelegate() const;
-  EngineValue *getNode() const;
-  uint64_t getOffset() const;
-  ValueDelegate getDelegate() const;
+  /**
+   * Strict weak ordering of delegates by their identity and offset. The order is only stable within a
+   * single run of icarus, as it depends on the addresses of the underlying objects.
+   */
+  bool operator<(const ValueDelegate &Other) const;
 };
 
+/**
+ * Hash function for ValueDelegate instances, consistent with ValueDelegate::operator==.
+ */
+llvm::hash_code hash_value(const ValueDelegate &Delegate);
+
+static_assert(std::is_trivially_copyable<ValueDelegate>::value, "ValueDelegate must be trivially copyable");
+static_assert(sizeof(ValueDelegate) == sizeof(void *), "ValueDelegate must fit into a single pointer");
+
+/**
+ * Class representing a single region in memory (e.g. a global variable or a stack allocation). Each of
+ * the regions is identified by its base, the llvm::Value which allocated the region. As EngineValues
+ * are copied when a forked ProgramContext modifies them, the base (and not the address of the object)
+ * is used to identify the same region across different program contexts.
+ *
+ * The content of the region is stored as a set of non-overlapping byte intervals (fragments), ordered
+ * by their offset. Each fragment holds the value stored in its bytes. If a store partially overwrites
+ * an existing fragment, the remaining bytes of the fragment are no longer a complete value and become
+ * unknown (i.e. they hold an invalid delegate). Adjacent unknown fragments are merged, so that a value
+ * that is repeatedly overwritten byte-wise does not fragment the region. Bytes which are not covered
+ * by any fragment have not been written yet. Accesses are bounded by the size of the region: stores and
+ * copies which exceed the region are rejected and leave it unchanged.
+ */
 class EngineValue {
 
-  std::map<uint64_t, ValueDelegate> Values;
+public:
+  /**
+   * A contiguous range of bytes in the memory region holding a single value.
+   */
+  struct Fragment {
+    uint64_t Size;
+    ValueDelegate Delegate;
+  };
+
+private:
+  llvm::Value *Base;
+
+  /* Fragments indexed by their offset into the region */
+  std::map<uint64_t, Fragment> Values;
 
   uint64_t Size;
 
+  using FragmentIterator = std::map<uint64_t, Fragment>::iterator;
+
+  /**
+   * Split the fragment covering the provided offset, such that a fragment starts at the offset. Both of
+   * the parts of a split fragment become unknown.
+   * @param Offset The offset at which to split.
+   */
+  void splitAt(uint64_t Offset);
+
+  /**
+   * Remove all bytes in the provided range. Fragments overlapping the boundaries of the range are split
+   * before the contained fragments are removed.
+   * @return An iterator to the first fragment after the range.
+   */
+  FragmentIterator eraseRange(uint64_t Offset, uint64_t Size);
+
+  /**
+   * Merge adjacent unknown fragments from the fragment preceding the range up to the fragment following
+   * the range.
+   */
+  void coalesce(uint64_t Begin, uint64_t End);
+
+  /**
+   * Merge the provided fragment with its predecessor, if both are unknown and adjacent.
+   * @return An iterator to the merged fragment.
+   */
+  FragmentIterator mergeWithPrevious(FragmentIterator I);
+
 public:
-  EngineValue(unsigned Size = 0) : Size(Size) {}
+  EngineValue(llvm::Value *Base = nullptr, uint64_t Size = 0) : Base(Base), Size(Size) {}
+
+  llvm::Value *getBase() const;
+  uint64_t getSize() const;
+
+  /**
+   * @return The number of fragments the region currently consists of.
+   */
+  std::size_t getNumFragments() const;
+
+  /**
+   * Returns the value the provided delegate points to, i.e. the value of the fragment starting at the
+   * offset of the delegate.
+   * @param Delegate The delegate pointing into this region.
+   * @return The value stored at the offset of the delegate or an invalid delegate.
+   */
+  ValueDelegate getDelegate(const ValueDelegate &Delegate) const;
+
+  /**
+   * Returns the value of the fragment starting at the provided offset, regardless of its size.
+   * @param Offset The offset into this region.
+   * @return The value stored at the offset or an invalid delegate.
+   */
+  ValueDelegate getDelegate(uint64_t Offset) const;
+
+  /**
+   * @param Offset The offset into this region.
+   * @param Size The number of bytes of the range.
+   * @return True, if the range lies within the bytes of this region.
+   */
+  bool contains(uint64_t Offset, uint64_t Size) const;
+
+  /**
+   * Store a value of the provided size. Fragments overlapping the range are split or replaced.
+   * @param Offset The offset into this region.
+   * @param Size The number of bytes of the stored value.
+   * @param Delegate The value to store, an invalid delegate marks the bytes as unknown.
+   * @return True, if the value has been stored, false if the range exceeds the region.
+   */
+  bool store(uint64_t Offset, uint64_t Size, ValueDelegate Delegate);
+
+  /**
+   * Store a value of the provided type, using the store size of the type in the llvm::DataLayout.
+   * @param DL The llvm::DataLayout of the analyzed program (see ExecutionEngine::getDataLayout).
+   * @param Offset The offset into this region.
+   * @param Ty The type of the stored value.
+   * @param Delegate The value to store.
+   * @return True, if the value has been stored, false if the range exceeds the region.
+   */
+  bool store(const llvm::DataLayout &DL, uint64_t Offset, llvm::Type *Ty, ValueDelegate Delegate);
+
+  /**
+   * Load a value of the provided size. Only a value written with exactly the same range can be loaded,
+   * loads covering partial, multiple or unwritten fragments result in an invalid delegate.
+   * @param Offset The offset into this region.
+   * @param Size The number of bytes to load.
+   * @return The loaded value or an invalid delegate.
+   */
+  ValueDelegate load(uint64_t Offset, uint64_t Size) const;
+
+  /**
+   * Load a value of the provided type, using the store size of the type in the llvm::DataLayout.
+   * @param DL The llvm::DataLayout of the analyzed program (see ExecutionEngine::getDataLayout).
+   * @param Offset The offset into this region.
+   * @param Ty The type of the loaded value.
+   * @return The loaded value or an invalid delegate.
+   */
+  ValueDelegate load(const llvm::DataLayout &DL, uint64_t Offset, llvm::Type *Ty) const;
 
-  ValueDelegate getDelegate(const ValueDelegate &Delegate);
-  void setDelegate(uint64_t Offset, ValueDelegate &Delegate);
+  /**
+   * Copy a range of bytes from a region into this region (e.g. for llvm.memcpy and llvm.memmove). The
+   * fragments of the source range are copied as a whole, fragments which are only partially contained
+   * in the source range are copied as unknown bytes. Source and destination may be the same region and
+   * the ranges may overlap.
+   * @param DstOffset The offset into this region.
+   * @param Src The region to copy from.
+   * @param SrcOffset The offset into the source region.
+   * @param Size The number of bytes to copy.
+   * @return True, if the bytes have been copied, false if either range exceeds its region.
+   */
+  bool copyRange(uint64_t DstOffset, const EngineValue &Src, uint64_t SrcOffset, uint64_t Size);
+
+  /**
+   * Call the provided function for each fragment in this region in ascending order of the offsets.
+   * @param Fn The function to call with the offset and the fragment.
+   */
+  template <typename Function> void forEachFragment(Function Fn) const {
+    for (const auto &Entry : Values)
+      Fn(Entry.first, Entry.second);
+  }
 };
 
 } // namespace icarus
@@ -0,0 +1,128 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_FRAMEPOOL_H
+#define ICARUS_ANALYSIS_FRAMEPOOL_H
+
+#include <icarus/Analysis/EngineValue.h>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * The storage for the values of a single call frame. Instances are acquired from the FramePool of the
+ * current thread and automatically returned to the pool of the thread that destroys them. Copying the
+ * storage (e.g. when a ProgramContext is forked) acquires a new storage from the pool.
+ */
+class FrameStorage {
+
+  ValueDelegate *Data = nullptr;
+  unsigned Size = 0;
+  unsigned Capacity = 0;
+
+  friend class FramePool;
+
+  FrameStorage(ValueDelegate *Data, unsigned Size, unsigned Capacity) : Data(Data), Size(Size), Capacity(Capacity) {}
+
+  /**
+   * Returns the storage to the pool of the current thread.
+   */
+  void reset();
+
+public:
+  FrameStorage() = default;
+
+  /**
+   * Acquire a new storage for the provided number of slots from the pool of the current thread.
+   * @param Size The number of slots of the storage.
+   */
+  explicit FrameStorage(unsigned Size);
+
+  FrameStorage(const FrameStorage &Other);
+  FrameStorage(FrameStorage &&Other) noexcept;
+  ~FrameStorage();
+  FrameStorage &operator=(const FrameStorage &Other);
+  FrameStorage &operator=(FrameStorage &&Other) noexcept;
+
+  unsigned size() const {
+    return Size;
+  }
+
+  unsigned capacity() const {
+    return Capacity;
+  }
+
+  ValueDelegate &operator[](unsigned Slot) {
+    return Data[Slot];
+  }
+
+  const ValueDelegate &operator[](unsigned Slot) const {
+    return Data[Slot];
+  }
+};
+
+/**
+ * Pool of reusable call frame storages. Pushing a call frame in a ProgramContext would otherwise need
+ * to allocate the storage for the values of the called function on every call and free it again upon
+ * returning from the function. Each thread has its own pool, so that no synchronization is required.
+ *
+ * The storages are kept in free lists bucketed by their capacity, which is always a power of two. The
+ * number of storages kept per bucket is limited, so that a single deep call chain does not retain its
+ * memory for the remaining analysis.
+ */
+class FramePool {
+
+  static constexpr unsigned MinCapacityLog2 = 3;
+  static constexpr unsigned NumBuckets = 16;
+  static constexpr unsigned MaxFreeFrames = 64;
+
+  std::array<std::vector<std::unique_ptr<ValueDelegate[]>>, NumBuckets> FreeLists;
+
+  /* Statistics of this pool */
+  std::size_t Acquired = 0;
+  std::size_t Reused = 0;
+
+  static unsigned getBucket(unsigned Capacity);
+
+public:
+  FramePool() = default;
+  FramePool(const FramePool &Other) = delete;
+  ~FramePool();
+  FramePool &operator=(const FramePool &Other) = delete;
+
+  /**
+   * @return The frame pool of the current thread.
+   */
+  static FramePool &get();
+
+  /**
+   * Acquire a storage with at least the provided number of slots. All slots are reset to invalid values.
+   * @param Size The number of slots of the storage.
+   * @return The storage for a call frame.
+   */
+  FrameStorage acquire(unsigned Size);
+
+  /**
+   * Return a storage to this pool.
+   * @param Storage The storage to release. The storage is empty afterwards.
+   */
+  void release(FrameStorage &Storage);
+
+  /**
+   * @return The number of storages acquired from this pool.
+   */
+  std::size_t getNumAcquired() const;
+
+  /**
+   * @return The number of acquired storages which were reused from previous call frames.
+   */
+  std::size_t getNumReused() const;
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_FRAMEPOOL_H
@@ -11,9 +11,13 @@
 #include <llvm/ExecutionEngine/GenericValue.h>
 
 #include <icarus/Analysis/EngineValue.h>
+#include <icarus/Analysis/FramePool.h>
+#include <icarus/Analysis/FunctionSlots.h>
 
 #include <nlohmann/json.hpp>
 
+#include <iterator>
+
 namespace icarus {
 
 /**
@@ -24,23 +28,121 @@ namespace icarus {
  *
  * This class represents a local execution context (i.e. the program state for a call frame). The code
  * for a global execution context is located in icarus::ProgramContext.
+ *
+ * The values of the call frame are stored in a contiguous array indexed by the slot numbers from the
+ * FunctionSlots of the executed function. Accessing an argument or the result of an instruction thus
+ * is a simple array access. The array is acquired from the FramePool of the current thread and reused
+ * for subsequent call frames after this context is destroyed.
  */
 template <typename AnalysisIterator> class FunctionContext {
 
+  llvm::Function *Func;
   llvm::BasicBlock *BB;
   typename AnalysisIterator::Iter II;
   llvm::CallInst *Caller;
-  std::map<llvm::Value *, ValueDelegate> Values;
+  const FunctionSlots *Slots;
+  FrameStorage Values;
 
 protected:
   /**
    * Create a new program state for a function context
    */
-  FunctionContext() : BB(nullptr), II(nullptr), Caller(nullptr) {}
+  FunctionContext() : Func(nullptr), BB(nullptr), II(nullptr), Caller(nullptr), Slots(nullptr) {}
 
 public:
+  /**
+   * Create a new call frame for the provided function.
+   * @param F The function to execute in this call frame.
+   * @param Caller The call instruction of the calling function, nullptr for entry functions.
+   */
+  explicit FunctionContext(llvm::Function &F, llvm::CallInst *Caller = nullptr)
+      : Func(&F), BB(AnalysisIterator::getEntryBlock(F)), Caller(Caller), Slots(&FunctionSlots::get(F)),
+        Values(Slots->getNumSlots()) {
+    if (BB)
+      II = AnalysisIterator::init(BB);
+  }
+
+  /**
+   * @return True, if the current basic block contains instructions which have not been visited yet.
+   */
+  bool hasNextInstruction() const {
+    return BB && II != AnalysisIterator::exit(BB);
+  }
+
   llvm::Instruction *nextInstruction() {
-    return *II++;
+    return &*II++;
+  }
+
+  llvm::Function *getFunction() const {
+    return Func;
+  }
+
+  llvm::BasicBlock *getBlock() const {
+    return BB;
+  }
+
+  llvm::CallInst *getCaller() const {
+    return Caller;
+  }
+
+  /**
+   * @return The number of instructions of the current basic block that have already been visited.
+   */
+  unsigned getPosition() const {
+    return BB ? std::distance(AnalysisIterator::init(BB), II) : 0;
+  }
+
+  /**
+   * Continue the execution of this call frame at the provided position (e.g. when restoring a call frame
+   * from a checkpoint).
+   * @param Block The basic block of the executed function.
+   * @param Position The number of instructions of the basic block that have already been visited.
+   */
+  void setPosition(llvm::BasicBlock *Block, unsigned Position) {
+    BB = Block;
+    if (BB)
+      II = std::next(AnalysisIterator::init(BB), Position);
+  }
+
+  const FunctionSlots &getSlots() const {
+    return *Slots;
+  }
+
+  /**
+   * @param Slot The slot of the local value.
+   * @return The value stored for the local value in this call frame.
+   */
+  const ValueDelegate &getValue(unsigned Slot) const {
+    return Values[Slot];
+  }
+
+  /**
+   * @param V The local value, i.e. an argument or instruction of the executed function.
+   * @return The value stored in this call frame, or an invalid delegate for non-local values.
+   */
+  ValueDelegate getValue(const llvm::Value *V) const {
+    int Slot = Slots->getSlot(V);
+    return Slot >= 0 ? Values[Slot] : ValueDelegate();
+  }
+
+  /**
+   * @param I The instruction whose operand to return.
+   * @param N The index of the operand.
+   * @return The value stored for the operand, or an invalid delegate for non-local operands.
+   */
+  ValueDelegate getOperandValue(const llvm::Instruction &I, unsigned N) const {
+    int Slot = Slots->getOperandSlots(I)[N];
+    return Slot >= 0 ? Values[Slot] : ValueDelegate();
+  }
+
+  void setValue(unsigned Slot, const ValueDelegate &Delegate) {
+    Values[Slot] = Delegate;
+  }
+
+  void setValue(const llvm::Value *V, const ValueDelegate &Delegate) {
+    int Slot = Slots->getSlot(V);
+    assert((Slot >= 0) && "Value is not local to the function");
+    Values[Slot] = Delegate;
   }
 };
 
@@ -0,0 +1,86 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_FUNCTIONSLOTS_H
+#define ICARUS_ANALYSIS_FUNCTIONSLOTS_H
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Instruction.h>
+
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Dense numbering of all local values (arguments and instructions) of a llvm::Function. Each of these
+ * values is assigned a slot number in the range [0, getNumSlots()), which allows a FunctionContext to
+ * store the values of a call frame in a contiguous array instead of a map.
+ *
+ * The class additionally precomputes the slots of all operands of each instruction, so that reading
+ * all operands of an instruction requires a single lookup of the instruction itself instead of one
+ * lookup per operand, and no lookup at all if the slot of the instruction is already known.
+ *
+ * The numbering of a function never changes, so instances are created once per function and shared
+ * between all threads via FunctionSlots::get.
+ */
+class FunctionSlots {
+
+  llvm::DenseMap<const llvm::Value *, unsigned> SlotMap;
+  std::vector<llvm::Value *> Values;
+
+  /* Operand slots of all instructions, indexed by OperandBegin[Slot] */
+  std::vector<unsigned> OperandBegin;
+  std::vector<int> OperandSlots;
+
+public:
+  /**
+   * Number all arguments and instructions of the provided function. Arguments receive the first slots
+   * in the order of their declaration, followed by all instructions in the order of their basic blocks.
+   * @param F The function whose values to number.
+   */
+  explicit FunctionSlots(llvm::Function &F);
+
+  /**
+   * Returns the cached numbering of the provided function, creating it upon the first request. It is
+   * safe to call this method from multiple threads.
+   * @param F The function for which to return the numbering.
+   * @return The numbering of the values of the function.
+   */
+  static const FunctionSlots &get(llvm::Function &F);
+
+  /**
+   * @return The number of local values in the function.
+   */
+  unsigned getNumSlots() const;
+
+  /**
+   * @param V The value to look up.
+   * @return The slot of the value, or -1 if the value is not local to the function (e.g. constants).
+   */
+  int getSlot(const llvm::Value *V) const;
+
+  /**
+   * @param Slot The slot number to look up.
+   * @return The argument or instruction numbered with the provided slot.
+   */
+  llvm::Value *getValue(unsigned Slot) const;
+
+  /**
+   * @param I The instruction whose operand slots to return.
+   * @return The slots of each operand of the instruction, or -1 for operands that are not local.
+   */
+  llvm::ArrayRef<int> getOperandSlots(const llvm::Instruction &I) const;
+
+  /**
+   * @param Slot The slot of the instruction whose operand slots to return.
+   * @return The slots of each operand of the instruction, or -1 for operands that are not local.
+   */
+  llvm::ArrayRef<int> getOperandSlots(unsigned Slot) const;
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_FUNCTIONSLOTS_H
@@ -0,0 +1,60 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_GLOBALSNAPSHOT_H
+#define ICARUS_ANALYSIS_GLOBALSNAPSHOT_H
+
+#include <icarus/ADT/PersistentMap.h>
+
+#include <icarus/Analysis/EngineValue.h>
+
+#include <memory>
+#include <string>
+
+namespace icarus {
+
+template <typename AnalysisIterator> class ProgramContext;
+
+/**
+ * Immutable snapshot of the global memory of a ProgramContext, usually taken after the global values of
+ * all modules have been allocated and the static constructors have been executed. Every analysis task
+ * which starts from an entry point can create its ProgramContext from the snapshot instead of repeating
+ * the initialization.
+ *
+ * The snapshot shares the nodes of its persistent maps with the contexts created from it. Creating a
+ * context is therefore O(1), and the EngineValues are only copied by the contexts that modify them. As
+ * the snapshot itself is never modified, it can be shared between threads without synchronization.
+ */
+class GlobalSnapshot {
+
+  template <typename AnalysisIterator> friend class ProgramContext;
+
+  adt::PersistentMap<std::string, llvm::Value *> NamedValues;
+  adt::PersistentMap<uint64_t, llvm::Value *> AddressableValues;
+  adt::PersistentMap<llvm::Value *, EngineValue> EngineValues;
+
+  GlobalSnapshot(const adt::PersistentMap<std::string, llvm::Value *> &NamedValues,
+                 const adt::PersistentMap<uint64_t, llvm::Value *> &AddressableValues,
+                 const adt::PersistentMap<llvm::Value *, EngineValue> &EngineValues)
+      : NamedValues(NamedValues), AddressableValues(AddressableValues), EngineValues(EngineValues) {}
+
+public:
+  /**
+   * @return The number of memory regions (EngineValues) in this snapshot.
+   */
+  std::size_t getNumEngineValues() const;
+
+  /**
+   * @param Base The llvm::Value which allocated the memory region.
+   * @return A pointer to the EngineValue, or nullptr if the region does not exist in this snapshot.
+   */
+  const EngineValue *getEngineValue(llvm::Value *Base) const;
+
+  llvm::Value *getNamedValue(const std::string &Name) const;
+  llvm::Value *getAddressableValue(uint64_t Address) const;
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_GLOBALSNAPSHOT_H
@@ -0,0 +1,47 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_LIVENESS_H
+#define ICARUS_ANALYSIS_LIVENESS_H
+
+#include <llvm/ADT/BitVector.h>
+#include <llvm/IR/BasicBlock.h>
+
+#include <icarus/Analysis/BackwardDataflow.h>
+#include <icarus/Analysis/FunctionSlots.h>
+
+namespace icarus {
+
+/**
+ * Liveness of the local values (arguments and instructions) of a function as a backward dataflow problem
+ * for the BackwardDataflow solver. The states are bit vectors indexed by the FunctionSlots of the values.
+ *
+ * A value used by a PHI node is only live at the end of the corresponding incoming block, not at the
+ * start of the block of the PHI node.
+ */
+class LivenessAnalysis {
+
+  const FunctionSlots &Slots;
+
+public:
+  using DomainT = llvm::BitVector;
+
+  explicit LivenessAnalysis(llvm::Function &F);
+
+  DomainT getInitial(llvm::BasicBlock &BB) const;
+  DomainT getBoundary(llvm::BasicBlock &Exit) const;
+  void meet(DomainT &Out, llvm::BasicBlock &BB, llvm::BasicBlock &Succ, const DomainT &SuccIn) const;
+  bool transfer(llvm::BasicBlock &BB, const DomainT &Out, DomainT &In) const;
+
+  /**
+   * @param Live The state of a basic block.
+   * @param V The value to look up.
+   * @return True, if the value is local to the function and live in the provided state.
+   */
+  bool isLive(const DomainT &Live, const llvm::Value *V) const;
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_LIVENESS_H
@@ -5,9 +5,16 @@
 #ifndef ICARUS_ANALYSIS_PROGRAMCONTEXT_H
 #define ICARUS_ANALYSIS_PROGRAMCONTEXT_H
 
+#include <llvm/IR/Module.h>
+
+#include <icarus/ADT/PersistentMap.h>
+
 #include <icarus/Analysis/EngineValue.h>
 #include <icarus/Analysis/FunctionContext.h>
+#include <icarus/Analysis/GlobalSnapshot.h>
 
+#include <deque>
+#include <memory>
 #include <stack>
 
 namespace icarus {
@@ -18,27 +25,216 @@ namespace icarus {
  *
  * This class represents a global execution context (i.e. the program state of a program). For a local
  * execution context, we user the class described in icarus::FunctionContext.
+ *
+ * The memory of a program context is persistent: All maps are stored in hash array mapped tries whose
+ * nodes are shared between forked contexts. Forking a context is therefore O(1) for its memory, and a
+ * forked context only copies the EngineValues it modifies (copy-on-write). The call stack is copied.
  */
 template <typename AnalysisIterator> class ProgramContext {
 
   /* Map of names and addresses to global values in LLVM IR */
-  std::map<std::string, llvm::Value *> NamedValues;
-  std::map<uint64_t, llvm::Value *> AddressableValues;
+  adt::PersistentMap<std::string, llvm::Value *> NamedValues;
+  adt::PersistentMap<uint64_t, llvm::Value *> AddressableValues;
 
   /* Map of global regions in memory, uniquely identifiable */
-  std::map<llvm::Value *, EngineValue> EngineValues;
+  adt::PersistentMap<llvm::Value *, EngineValue> EngineValues;
 
   std::deque<FunctionContext<AnalysisIterator>> FCStack;
 
 public:
   ProgramContext() = default;
 
+  /**
+   * Create a new program context from the global memory of the provided snapshot. The memory is shared
+   * with the snapshot and only copied for the regions this context modifies. The call stack is empty.
+   * @param Snapshot The snapshot of the initialized global memory.
+   */
+  explicit ProgramContext(const GlobalSnapshot &Snapshot)
+      : NamedValues(Snapshot.NamedValues), AddressableValues(Snapshot.AddressableValues),
+        EngineValues(Snapshot.EngineValues) {}
+
+  /**
+   * Create a new program context which shares its entire memory with this context. Subsequent changes
+   * to either of the contexts are not visible in the other context.
+   * @return The forked program context.
+   */
+  ProgramContext fork() const {
+    return ProgramContext(*this);
+  }
+
+  /**
+   * Capture the global memory of this context in an immutable snapshot. This is supposed to be called
+   * after the initialization of the global values, i.e. before any entry function is executed.
+   * @return The snapshot which can be shared between all analysis tasks.
+   */
+  std::shared_ptr<const GlobalSnapshot> takeSnapshot() const {
+    assert((isStackEmpty()) && "Snapshots can only be taken from contexts with an empty call stack");
+    return std::shared_ptr<const GlobalSnapshot>(new GlobalSnapshot(NamedValues, AddressableValues, EngineValues));
+  }
+
+  /**
+   * Allocate the memory regions for all global variables defined in the provided module and register
+   * them by their names. The sizes of the regions are taken from the llvm::DataLayout of the module.
+   * @param M The module whose global variables to allocate.
+   */
+  void allocateGlobalValues(llvm::Module &M) {
+    const llvm::DataLayout &DL = M.getDataLayout();
+    for (llvm::GlobalVariable &GV : M.globals()) {
+      if (GV.isDeclaration())
+        continue;
+      allocateEngineValue(&GV, DL.getTypeAllocSize(GV.getValueType()));
+      setNamedValue(GV.getName().str(), &GV);
+    }
+  }
+
   bool isStackEmpty() const {
     return FCStack.empty();
   }
 
+  /**
+   * @return The number of call frames on the call stack.
+   */
+  std::size_t getStackDepth() const {
+    return FCStack.size();
+  }
+
   FunctionContext<AnalysisIterator> &getCurrentFunctionStack() {
-    return FCStack.front().get();
+    return FCStack.back();
+  }
+
+  /**
+   * @return The basic block executed in the current call frame, or nullptr if the call stack is empty.
+   */
+  const llvm::BasicBlock *getCurrentBlock() const {
+    return FCStack.empty() ? nullptr : FCStack.back().getBlock();
+  }
+
+  /**
+   * @param N The index of the call frame, starting with the outermost (entry) function.
+   * @return The call frame at the provided index.
+   */
+  const FunctionContext<AnalysisIterator> &getFunctionContext(std::size_t N) const {
+    return FCStack[N];
+  }
+
+  /**
+   * Push a new call frame for the provided function onto the call stack. The storage for the values of
+   * the call frame is taken from the FramePool of the current thread.
+   * @param F The function to execute.
+   * @param Caller The call instruction in the current call frame, nullptr for entry functions.
+   * @return A reference to the new call frame.
+   */
+  FunctionContext<AnalysisIterator> &pushFunctionContext(llvm::Function &F, llvm::CallInst *Caller = nullptr) {
+    return FCStack.emplace_back(F, Caller);
+  }
+
+  /**
+   * Remove the current call frame from the call stack and return its storage to the FramePool.
+   */
+  void popFunctionContext() {
+    FCStack.pop_back();
+  }
+
+  /*
+   * Memory methods
+   */
+
+  /**
+   * @return The number of memory regions (EngineValues) in this context.
+   */
+  std::size_t getNumEngineValues() const {
+    return EngineValues.size();
+  }
+
+  /**
+   * Look up the memory region allocated by the provided base without copying it.
+   * @param Base The llvm::Value which allocated the memory region.
+   * @return A pointer to the EngineValue, or nullptr if the region does not exist in this context.
+   */
+  const EngineValue *getEngineValue(llvm::Value *Base) const {
+    return EngineValues.lookup(Base);
+  }
+
+  /**
+   * Look up the memory region allocated by the provided base for modification. If the region is shared
+   * with a forked context, it is copied before it is returned.
+   * @param Base The llvm::Value which allocated the memory region.
+   * @return A pointer to the EngineValue, or nullptr if the region does not exist in this context.
+   */
+  EngineValue *getMutableEngineValue(llvm::Value *Base) {
+    return EngineValues.lookupMutable(Base);
+  }
+
+  /**
+   * Allocate a new memory region for the provided base. Existing regions for the same base are replaced.
+   * @param Base The llvm::Value which allocates the memory region.
+   * @param Size The size of the memory region in bytes.
+   * @return A reference to the newly allocated EngineValue.
+   */
+  EngineValue &allocateEngineValue(llvm::Value *Base, uint64_t Size) {
+    EngineValues.insert(Base, EngineValue(Base, Size));
+    return *EngineValues.lookupMutable(Base);
+  }
+
+  /**
+   * Remove the memory region for the provided base from this context.
+   * @param Base The llvm::Value which allocated the memory region.
+   * @return True, if the memory region existed.
+   */
+  bool freeEngineValue(llvm::Value *Base) {
+    return EngineValues.erase(Base);
+  }
+
+  /**
+   * Call the provided function for each memory region in this context (in no particular order).
+   * @param Function The function to call with the base and the EngineValue of each region.
+   */
+  template <typename Func> void forEachEngineValue(Func &&Function) const {
+    EngineValues.forEach(std::forward<Func>(Function));
+  }
+
+  /**
+   * Resolve the value the provided delegate is pointing to in this context. As delegates might have been
+   * created in a context this context was forked from, they only store the base of the region, which is
+   * looked up in this context.
+   * @param Delegate The delegate pointing to a memory region.
+   * @return The value stored at the offset of the delegate or an invalid delegate.
+   */
+  ValueDelegate getDelegate(const ValueDelegate &Delegate) const {
+    if (!Delegate.isNodeDelegate())
+      return ValueDelegate();
+    const EngineValue *EV = getEngineValue(Delegate.getBase());
+    return EV ? EV->getDelegate(Delegate.getOffset()) : ValueDelegate();
+  }
+
+  /*
+   * Named and addressable values
+   */
+
+  llvm::Value *getNamedValue(const std::string &Name) const {
+    llvm::Value *const *V = NamedValues.lookup(Name);
+    return V ? *V : nullptr;
+  }
+
+  void setNamedValue(const std::string &Name, llvm::Value *V) {
+    NamedValues.insert(Name, V);
+  }
+
+  llvm::Value *getAddressableValue(uint64_t Address) const {
+    llvm::Value *const *V = AddressableValues.lookup(Address);
+    return V ? *V : nullptr;
+  }
+
+  void setAddressableValue(uint64_t Address, llvm::Value *V) {
+    AddressableValues.insert(Address, V);
+  }
+
+  template <typename Func> void forEachNamedValue(Func &&Function) const {
+    NamedValues.forEach(std::forward<Func>(Function));
+  }
+
+  template <typename Func> void forEachAddressableValue(Func &&Function) const {
+    AddressableValues.forEach(std::forward<Func>(Function));
   }
 };
 
@@ -0,0 +1,26 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_SCHEDULINGPOLICY_H
+#define ICARUS_ANALYSIS_SCHEDULINGPOLICY_H
+
+namespace icarus {
+
+/**
+ * The order in which pending program contexts are executed by the analysis workers.
+ */
+enum class SchedulingPolicy {
+  /* Continue with the most recently scheduled context (e.g. the last forked path) */
+  DFS,
+  /* Continue with the least recently scheduled context */
+  BFS,
+  /* Continue with the context whose current basic block has been executed the least */
+  Coverage,
+  /* Continue with the context with the fewest call frames */
+  ShortestStack
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_SCHEDULINGPOLICY_H
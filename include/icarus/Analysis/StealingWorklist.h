@@ -0,0 +1,285 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_STEALINGWORKLIST_H
+#define ICARUS_ANALYSIS_STEALINGWORKLIST_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Counters of a StealingWorklist, collected over the lifetime of the worklist.
+ */
+struct StealingStatistics {
+  /* Contexts pushed by all workers */
+  uint64_t Pushed = 0;
+  /* Contexts acquired from the own deque of a worker */
+  uint64_t Popped = 0;
+  /* Contexts acquired from the deque of another worker */
+  uint64_t Stolen = 0;
+  /* Steal attempts which did not find any context */
+  uint64_t FailedSteals = 0;
+  /* Lock acquisitions of a deque which had to wait for another worker */
+  uint64_t Contended = 0;
+};
+
+/**
+ * Worklist of pending program contexts with a separate double-ended queue for each worker. Workers push
+ * the contexts they fork or interrupt to the back of their own deque and continue with the context at
+ * the back (depth-first), so that the memory of recently executed contexts is still in the cache of the
+ * worker. Workers without any pending context steal the oldest context from the front of the deque of
+ * another worker, which is usually the root of the largest unexplored subtree.
+ *
+ * Each deque is guarded by its own mutex, which is only contended if another worker steals from it at
+ * the same time. Apart from that, the interface is the same as for icarus::Worklist, except that push
+ * and acquire take the index of the calling worker and no coverage is recorded, as the deques are always
+ * ordered depth-first.
+ * @tparam ContextT The program context type, e.g. ProgramContext<DefaultAnalysisIterator>.
+ */
+template <typename ContextT> class StealingWorklist {
+
+  struct alignas(64) WorkerQueue {
+    std::mutex Mutex;
+    std::deque<ContextT> Contexts;
+    uint32_t Seed;
+
+    /* Counters of the owning worker, only modified by the owner */
+    std::atomic<uint64_t> Pushed = 0;
+    std::atomic<uint64_t> Popped = 0;
+    std::atomic<uint64_t> Stolen = 0;
+    std::atomic<uint64_t> FailedSteals = 0;
+    std::atomic<uint64_t> Contended = 0;
+  };
+
+  std::vector<std::unique_ptr<WorkerQueue>> Queues;
+
+  /*
+   * Queued is incremented before Active is decremented upon releasing a context, and Active is incremented
+   * before Queued is decremented upon acquiring a context. Thus, observing both counters as zero implies
+   * that no context is left to execute.
+   */
+  std::atomic<std::size_t> Queued = 0;
+  std::atomic<unsigned> Active = 0;
+  std::atomic<unsigned> Sleeping = 0;
+  std::atomic<bool> Paused = false;
+
+  std::mutex SleepMutex;
+  std::condition_variable Sleep;
+
+  void lock(WorkerQueue &Queue, WorkerQueue &Self) {
+    if (!Queue.Mutex.try_lock()) {
+      Self.Contended.fetch_add(1, std::memory_order_relaxed);
+      Queue.Mutex.lock();
+    }
+  }
+
+  bool popLocal(unsigned Worker, ContextT &Context) {
+    WorkerQueue &Self = *Queues[Worker];
+    lock(Self, Self);
+    std::unique_lock<std::mutex> Lock(Self.Mutex, std::adopt_lock);
+    if (Self.Contexts.empty())
+      return false;
+    Context = std::move(Self.Contexts.back());
+    Self.Contexts.pop_back();
+    Queued.fetch_sub(1);
+    Self.Popped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool steal(unsigned Worker, ContextT &Context) {
+    WorkerQueue &Self = *Queues[Worker];
+    unsigned NumQueues = Queues.size();
+
+    /* Start at a random victim, so that idle workers do not all steal from the same deque */
+    Self.Seed ^= Self.Seed << 13;
+    Self.Seed ^= Self.Seed >> 17;
+    Self.Seed ^= Self.Seed << 5;
+
+    for (unsigned N = 0; N < NumQueues; ++N) {
+      unsigned Victim = (Self.Seed + N) % NumQueues;
+      if (Victim == Worker)
+        continue;
+
+      WorkerQueue &Other = *Queues[Victim];
+      lock(Other, Self);
+      std::unique_lock<std::mutex> Lock(Other.Mutex, std::adopt_lock);
+      if (Other.Contexts.empty())
+        continue;
+      Context = std::move(Other.Contexts.front());
+      Other.Contexts.pop_front();
+      Queued.fetch_sub(1);
+      Self.Stolen.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    Self.FailedSteals.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * Decrement the number of active workers and wake up all waiting workers if either the analysis has
+   * finished or a worker waits for all other workers to become idle.
+   */
+  void deactivate() {
+    if (Active.fetch_sub(1) != 1)
+      return;
+    if (Queued.load() == 0 || Paused.load()) {
+      std::lock_guard<std::mutex> Lock(SleepMutex);
+      Sleep.notify_all();
+    }
+  }
+
+public:
+  explicit StealingWorklist(unsigned NumWorkers) {
+    for (unsigned N = 0; N < std::max(1U, NumWorkers); ++N) {
+      Queues.push_back(std::make_unique<WorkerQueue>());
+      Queues.back()->Seed = 0x9E3779B9U * (N + 1);
+    }
+  }
+
+  unsigned getNumWorkers() const {
+    return Queues.size();
+  }
+
+  /**
+   * @return The number of pending (not acquired) contexts.
+   */
+  std::size_t size() const {
+    return Queued.load();
+  }
+
+  /**
+   * Add a context to the deque of the provided worker.
+   * @param Worker The index of the calling worker.
+   * @param Context The context to schedule.
+   */
+  void push(unsigned Worker, ContextT &&Context) {
+    WorkerQueue &Self = *Queues[Worker % Queues.size()];
+    {
+      lock(Self, Self);
+      std::lock_guard<std::mutex> Lock(Self.Mutex, std::adopt_lock);
+      Self.Contexts.push_back(std::move(Context));
+      Queued.fetch_add(1);
+    }
+    Self.Pushed.fetch_add(1, std::memory_order_relaxed);
+
+    if (Sleeping.load()) {
+      std::lock_guard<std::mutex> Lock(SleepMutex);
+      Sleep.notify_one();
+    }
+  }
+
+  /**
+   * Acquire the next context, either from the own deque or by stealing from another worker. The method
+   * blocks until a context is available or the analysis is finished.
+   * @param Worker The index of the calling worker.
+   * @param Context The acquired context.
+   * @return False, if no context is left and no other worker is able to schedule new contexts.
+   */
+  bool acquire(unsigned Worker, ContextT &Context) {
+    for (;;) {
+      Active.fetch_add(1);
+      if (!Paused.load() && (popLocal(Worker, Context) || steal(Worker, Context)))
+        return true;
+      deactivate();
+
+      std::unique_lock<std::mutex> Lock(SleepMutex);
+      Sleeping.fetch_add(1);
+      Sleep.wait(Lock, [&]() { return !Paused.load() && (Queued.load() || !Active.load()); });
+      Sleeping.fetch_sub(1);
+      if (!Queued.load() && !Active.load()) {
+        Sleep.notify_all();
+        return false;
+      }
+    }
+  }
+
+  /**
+   * Release a context acquired by StealingWorklist::acquire. The context (if it is not finished) and its
+   * forks have to be pushed before it is released.
+   */
+  void release() {
+    deactivate();
+  }
+
+  /**
+   * Wait until no context is acquired and call the provided function with copies of all pending contexts
+   * while no worker can acquire a context. The calling thread must not hold an acquired context.
+   * @param Function The function to call with a vector of all pending contexts.
+   */
+  template <typename Func> void pause(Func &&Function) {
+    std::unique_lock<std::mutex> Lock(SleepMutex);
+    Sleep.wait(Lock, [&]() { return !Paused.load(); });
+    Paused.store(true);
+    Sleep.wait(Lock, [&]() { return !Active.load(); });
+
+    std::vector<ContextT> Contexts;
+    for (const std::unique_ptr<WorkerQueue> &Queue : Queues) {
+      std::lock_guard<std::mutex> QueueLock(Queue->Mutex);
+      Contexts.insert(Contexts.end(), Queue->Contexts.begin(), Queue->Contexts.end());
+    }
+    Function(Contexts);
+
+    Paused.store(false);
+    Sleep.notify_all();
+  }
+
+  /**
+   * View of the worklist for a single worker, providing the same interface as icarus::Worklist.
+   */
+  class WorkerHandle {
+
+    StealingWorklist &WL;
+    unsigned Worker;
+
+  public:
+    WorkerHandle(StealingWorklist &WL, unsigned Worker) : WL(WL), Worker(Worker) {}
+
+    void push(ContextT &&Context) {
+      WL.push(Worker, std::move(Context));
+    }
+
+    bool acquire(ContextT &Context) {
+      return WL.acquire(Worker, Context);
+    }
+
+    void release() {
+      WL.release();
+    }
+
+    template <typename Func> void pause(Func &&Function) {
+      WL.pause(std::forward<Func>(Function));
+    }
+  };
+
+  WorkerHandle getHandle(unsigned Worker) {
+    return WorkerHandle(*this, Worker);
+  }
+
+  /**
+   * @return The sum of the counters of all workers.
+   */
+  StealingStatistics getStatistics() const {
+    StealingStatistics Statistics;
+    for (const std::unique_ptr<WorkerQueue> &Queue : Queues) {
+      Statistics.Pushed += Queue->Pushed.load(std::memory_order_relaxed);
+      Statistics.Popped += Queue->Popped.load(std::memory_order_relaxed);
+      Statistics.Stolen += Queue->Stolen.load(std::memory_order_relaxed);
+      Statistics.FailedSteals += Queue->FailedSteals.load(std::memory_order_relaxed);
+      Statistics.Contended += Queue->Contended.load(std::memory_order_relaxed);
+    }
+    return Statistics;
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_STEALINGWORKLIST_H
@@ -0,0 +1,87 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_TASKID_H
+#define ICARUS_ANALYSIS_TASKID_H
+
+#include <llvm/ADT/SmallVector.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+namespace icarus {
+
+/**
+ * Hierarchical identifier of an analysis task. The initial tasks are numbered in the order they were
+ * scheduled, each task forked from another task receives the identifier of its parent extended by the
+ * number of the fork. The identifiers therefore only depend on the program and never on the order in
+ * which the tasks were executed, which allows ordering tasks and their results deterministically.
+ */
+class TaskID {
+
+  llvm::SmallVector<uint32_t, 8> Path;
+
+public:
+  TaskID() = default;
+  explicit TaskID(uint32_t Root) : Path({Root}) {}
+
+  /**
+   * @param N The number of the fork, unique among all forks of this task.
+   * @return The identifier of the N-th fork of this task.
+   */
+  TaskID getChild(uint32_t N) const {
+    TaskID Child(*this);
+    Child.Path.push_back(N);
+    return Child;
+  }
+
+  unsigned getDepth() const {
+    return Path.size();
+  }
+
+  /**
+   * Compute a hash of the identifier which is stable across different runs (e.g. to seed generators).
+   * @param Seed The initial value of the hash.
+   * @param Step An additional value to distinguish multiple hashes of the same task.
+   * @return The hash of the seed, the identifier and the step.
+   */
+  uint64_t getStableHash(uint64_t Seed = 0, uint64_t Step = 0) const {
+    uint64_t Hash = 0xcbf29ce484222325ULL ^ Seed;
+    for (uint32_t Element : Path) {
+      Hash ^= Element;
+      Hash *= 0x100000001b3ULL;
+    }
+    return (Hash ^ Step) * 0x100000001b3ULL;
+  }
+
+  /**
+   * @return The identifier in the form "0.2.1".
+   */
+  std::string str() const {
+    std::string String;
+    for (uint32_t Element : Path) {
+      if (!String.empty())
+        String += '.';
+      String += std::to_string(Element);
+    }
+    return String;
+  }
+
+  /**
+   * Lexicographical order, so that each task precedes its forks and the forks of a task precede all tasks
+   * with a greater identifier (i.e. a depth-first order of the tree of tasks).
+   */
+  bool operator<(const TaskID &Other) const {
+    return std::lexicographical_compare(Path.begin(), Path.end(), Other.Path.begin(), Other.Path.end());
+  }
+
+  bool operator==(const TaskID &Other) const {
+    return Path == Other.Path;
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_TASKID_H
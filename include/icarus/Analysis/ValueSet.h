@@ -0,0 +1,140 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_VALUESET_H
+#define ICARUS_ANALYSIS_VALUESET_H
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/SmallVector.h>
+
+#include <icarus/Analysis/EngineValue.h>
+
+#include <memory>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * The interned storage of a ValueSet with more elements than fit into the inline storage. Equal sets
+ * are guaranteed to share the same storage instance, which allows comparing them by their address.
+ */
+struct ValueSetStorage {
+  std::size_t Hash;
+  std::vector<ValueDelegate> Elements;
+};
+
+/**
+ * Set of values an instruction may evaluate to, if the value is not uniquely determinable. Instead of
+ * collapsing to an invalid ValueDelegate, the analysis can keep track of all candidates (e.g. targets
+ * of an indirect call) and merge them at control flow joins.
+ *
+ * Small sets are stored inline as a sorted vector. Larger sets are hash-consed: They are interned in a
+ * global, thread-safe table, so that equal sets share the same storage across all program contexts.
+ * Equality of large sets is a pointer comparison and unions of the same pair of sets are memoized.
+ *
+ * A set may also be unknown, i.e. it contains values that are not determinable at all. Unknown sets
+ * absorb all other sets on union.
+ */
+class ValueSet {
+
+  static constexpr unsigned InlineSize = 4;
+
+  llvm::SmallVector<ValueDelegate, InlineSize> Inline;
+  std::shared_ptr<const ValueSetStorage> Shared;
+  bool Unknown = false;
+
+  /**
+   * Creates a set from sorted and deduplicated elements, interning them if necessary.
+   */
+  static ValueSet fromSorted(llvm::ArrayRef<ValueDelegate> Elements);
+
+public:
+  /**
+   * Creates an empty set.
+   */
+  ValueSet() = default;
+
+  /**
+   * Creates a set containing the provided delegate. Invalid delegates create an unknown set.
+   * @param Delegate The only element of the set.
+   */
+  explicit ValueSet(const ValueDelegate &Delegate);
+
+  /**
+   * Creates a set with the provided delegates. The delegates do not need to be sorted or unique.
+   * @param Delegates The elements of the set.
+   */
+  explicit ValueSet(llvm::ArrayRef<ValueDelegate> Delegates);
+
+  /**
+   * @return A set which represents values that cannot be determined.
+   */
+  static ValueSet getUnknown();
+
+  bool isUnknown() const;
+  bool empty() const;
+  std::size_t size() const;
+
+  /**
+   * @return The sorted elements of this set. Empty for unknown sets.
+   */
+  llvm::ArrayRef<ValueDelegate> elements() const;
+
+  const ValueDelegate *begin() const {
+    return elements().begin();
+  }
+
+  const ValueDelegate *end() const {
+    return elements().end();
+  }
+
+  bool contains(const ValueDelegate &Delegate) const;
+
+  /**
+   * Returns the sole element of this set. This allows passes which only deal with uniquely determinable
+   * values to keep using ValueDelegate instances.
+   * @return The sole element, or an invalid delegate if the set does not have exactly one element.
+   */
+  ValueDelegate getUniqueDelegate() const;
+
+  /**
+   * Computes the union of this and the provided set.
+   * @param Other The set to merge with this set.
+   * @return The union of both sets.
+   */
+  ValueSet merge(const ValueSet &Other) const;
+
+  /**
+   * Merge the provided set into this set.
+   * @param Other The set to merge into this set.
+   * @return True, if this set has changed.
+   */
+  bool mergeWith(const ValueSet &Other);
+
+  /**
+   * Insert a single delegate into this set.
+   * @param Delegate The delegate to insert. Invalid delegates make this set unknown.
+   * @return True, if this set has changed.
+   */
+  bool insert(const ValueDelegate &Delegate);
+
+  /**
+   * @return True, if the elements of this set are stored in the interned storage.
+   */
+  bool isInterned() const;
+
+  bool operator==(const ValueSet &Other) const;
+  bool operator!=(const ValueSet &Other) const;
+
+  friend llvm::hash_code hash_value(const ValueSet &Set);
+};
+
+/**
+ * Hash function for ValueSet instances, consistent with ValueSet::operator==.
+ */
+llvm::hash_code hash_value(const ValueSet &Set);
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_VALUESET_H
@@ -0,0 +1,215 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_ANALYSIS_WORKLIST_H
+#define ICARUS_ANALYSIS_WORKLIST_H
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/IR/BasicBlock.h>
+
+#include <icarus/Analysis/SchedulingPolicy.h>
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Thread-safe worklist of pending program contexts. Workers acquire a context, execute it for a quantum
+ * of instructions and push it back (together with all contexts forked in the meantime) before they
+ * release it. The analysis is finished as soon as the worklist is empty and no context is acquired.
+ *
+ * Contexts are ordered by the scheduling policy of the worklist. DFS and BFS use a double-ended queue,
+ * the remaining policies use a binary heap ordered by a priority that is computed when a context is
+ * pushed. Contexts with the same priority are executed in the order they have been pushed.
+ * @tparam ContextT The program context type, e.g. ProgramContext<DefaultAnalysisIterator>.
+ */
+template <typename ContextT> class Worklist {
+
+  struct Entry {
+    uint64_t Priority;
+    uint64_t Sequence;
+    ContextT Context;
+
+    /* Inverted for the max-heap of the standard library */
+    bool operator<(const Entry &Other) const {
+      return std::tie(Priority, Sequence) > std::tie(Other.Priority, Other.Sequence);
+    }
+  };
+
+  SchedulingPolicy Policy;
+  std::deque<ContextT> Queue;
+  std::vector<Entry> Heap;
+  uint64_t Sequence = 0;
+
+  /* Number of times each basic block has been entered, only recorded for SchedulingPolicy::Coverage */
+  llvm::DenseMap<const llvm::BasicBlock *, uint64_t> Coverage;
+
+  mutable std::mutex Mutex;
+  std::condition_variable Available;
+  std::condition_variable Idle;
+  unsigned Active = 0;
+  bool Paused = false;
+
+  bool usesHeap() const {
+    return Policy == SchedulingPolicy::Coverage || Policy == SchedulingPolicy::ShortestStack;
+  }
+
+  bool isEmpty() const {
+    return Queue.empty() && Heap.empty();
+  }
+
+  uint64_t getPriority(const ContextT &Context) const {
+    if (Policy == SchedulingPolicy::ShortestStack)
+      return Context.getStackDepth();
+    return Coverage.lookup(Context.getCurrentBlock());
+  }
+
+public:
+  explicit Worklist(SchedulingPolicy Policy = SchedulingPolicy::DFS) : Policy(Policy) {}
+
+  SchedulingPolicy getPolicy() const {
+    return Policy;
+  }
+
+  /**
+   * Change the scheduling policy. Only possible as long as the worklist is empty.
+   * @param NewPolicy The new scheduling policy.
+   */
+  void setPolicy(SchedulingPolicy NewPolicy) {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    assert((isEmpty()) && "Cannot change the scheduling policy of a non-empty worklist");
+    Policy = NewPolicy;
+  }
+
+  /**
+   * @return The number of pending (not acquired) contexts.
+   */
+  std::size_t size() const {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Queue.size() + Heap.size();
+  }
+
+  /**
+   * Remove all pending contexts from the worklist, e.g. to distribute them to another worklist.
+   * @return The pending contexts in the order of the scheduling policy.
+   */
+  std::vector<ContextT> takeAll() {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    std::vector<ContextT> Contexts;
+    if (Policy == SchedulingPolicy::DFS)
+      Contexts.assign(std::make_move_iterator(Queue.rbegin()), std::make_move_iterator(Queue.rend()));
+    else
+      Contexts.assign(std::make_move_iterator(Queue.begin()), std::make_move_iterator(Queue.end()));
+    for (; !Heap.empty(); Heap.pop_back()) {
+      std::pop_heap(Heap.begin(), Heap.end());
+      Contexts.push_back(std::move(Heap.back().Context));
+    }
+    Queue.clear();
+    return Contexts;
+  }
+
+  /**
+   * Add a context to the worklist.
+   * @param Context The context to schedule.
+   */
+  void push(ContextT &&Context) {
+    {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      if (usesHeap()) {
+        uint64_t Priority = getPriority(Context);
+        Heap.push_back({Priority, Sequence++, std::move(Context)});
+        std::push_heap(Heap.begin(), Heap.end());
+      } else {
+        Queue.push_back(std::move(Context));
+      }
+    }
+    Available.notify_one();
+  }
+
+  /**
+   * Acquire the next context according to the scheduling policy. The method blocks until a context is
+   * available or the analysis is finished. Each acquired context has to be released after its quantum.
+   * @param Context The acquired context.
+   * @return False, if the worklist is empty and no other worker is able to schedule new contexts.
+   */
+  bool acquire(ContextT &Context) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Available.wait(Lock, [&]() { return !Paused && (!isEmpty() || !Active); });
+    if (isEmpty())
+      return false;
+
+    if (usesHeap()) {
+      std::pop_heap(Heap.begin(), Heap.end());
+      Context = std::move(Heap.back().Context);
+      Heap.pop_back();
+    } else if (Policy == SchedulingPolicy::DFS) {
+      Context = std::move(Queue.back());
+      Queue.pop_back();
+    } else {
+      Context = std::move(Queue.front());
+      Queue.pop_front();
+    }
+
+    ++Active;
+    return true;
+  }
+
+  /**
+   * Release a context acquired by Worklist::acquire. The context (if it is not finished) and its forks
+   * have to be pushed before it is released, otherwise other workers may finish prematurely.
+   */
+  void release() {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (--Active)
+      return;
+    Idle.notify_all();
+    Available.notify_all();
+  }
+
+  /**
+   * Record the basic blocks entered during the execution of a context.
+   * @param Blocks The entered basic blocks.
+   */
+  void recordCoverage(llvm::ArrayRef<const llvm::BasicBlock *> Blocks) {
+    if (Policy != SchedulingPolicy::Coverage || Blocks.empty())
+      return;
+    std::lock_guard<std::mutex> Lock(Mutex);
+    for (const llvm::BasicBlock *BB : Blocks)
+      ++Coverage[BB];
+  }
+
+  /**
+   * Wait until no context is acquired and call the provided function with copies of all pending contexts
+   * while no worker can acquire a context. This is used for consistent checkpoints of the worklist. The
+   * calling thread must not hold an acquired context.
+   * @param Function The function to call with a vector of all pending contexts.
+   */
+  template <typename Func> void pause(Func &&Function) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Idle.wait(Lock, [&]() { return !Paused; });
+    Paused = true;
+    Idle.wait(Lock, [&]() { return !Active; });
+
+    std::vector<ContextT> Contexts(Queue.begin(), Queue.end());
+    for (const Entry &E : Heap)
+      Contexts.push_back(E.Context);
+    Function(Contexts);
+
+    Paused = false;
+    Idle.notify_all();
+    Available.notify_all();
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_ANALYSIS_WORKLIST_H
@@ -44,10 +44,11 @@ struct LogMessage {
 };
 
 /**
- * Full template specialization of the thread safe queue used for propagating logging messages to an
- * instance of a logger. Each logger thread automatically allocates a new queue.
+ * Full template specialization of the lock-free queue used for propagating logging messages to an
+ * instance of a logger. Each logger thread automatically allocates a new queue. Threads logging a
+ * message block while the queue is full, until the logger thread has caught up.
  */
-class LogMessageQueue : public ThreadSafeQueue<LogMessageQueue, LogMessage> {};
+class LogMessageQueue : public MPMCQueue<LogMessageQueue, LogMessage> {};
 
 /**
  * Base class for all loggers. Each subclass might to implement the two virtual methods for prepending
@@ -175,6 +176,48 @@ public:
   void shutdown();
 };
 
+/**
+ * Buffer for the log messages of the current thread. While a buffer exists, all messages logged by the
+ * thread are stored in the buffer instead of being sent to the loggers. This allows to publish messages
+ * of concurrently executed tasks in a deterministic order (e.g. in the order of the task IDs). Buffers
+ * can be nested: Messages that were not taken from a buffer are passed to the enclosing buffer of the
+ * thread, or to the loggers, when the buffer is destroyed.
+ */
+class LogBuffer {
+
+  std::vector<LogMessage> Messages;
+  LogBuffer *Parent;
+
+public:
+  LogBuffer();
+  ~LogBuffer();
+
+  LogBuffer(const LogBuffer &) = delete;
+  LogBuffer &operator=(const LogBuffer &) = delete;
+
+  /**
+   * @return The innermost buffer of the current thread, or nullptr if the thread has no buffer.
+   */
+  static LogBuffer *getCurrent();
+
+  void add(LogMessage &&Message);
+
+  /**
+   * Remove all buffered messages, e.g. in order to publish them later with logMessage.
+   * @return The buffered messages in the order they were logged.
+   */
+  std::vector<LogMessage> take();
+};
+
+/**
+ * Omit the timestamp and thread ID from all subsequent log messages. Both depend on the execution of a
+ * specific run and would prevent two runs of a deterministic analysis from producing identical logs.
+ * @param Enable True, if the log messages should only depend on their arguments.
+ */
+void setDeterministicOutput(bool Enable);
+
+bool isDeterministicOutput();
+
 /**
  * Formats the log message and adds more information such as the timestamp (default: H:m:s), and the
  * normalized thread ID from which the log message originates from.
@@ -185,6 +228,11 @@ public:
  */
 template <typename... Args> static std::string formatMessage(unsigned ThreadID, Args &&...args) {
   std::stringstream Buffer;
+  if (isDeterministicOutput()) {
+    ((Buffer << " "));
+    ((Buffer << std::forward<Args>(args)), ...);
+    return Buffer.str();
+  }
   auto Clock = std::chrono::system_clock::now();
   auto Time = std::chrono::system_clock::to_time_t(Clock);
   ((Buffer << "[" << std::put_time(std::localtime(&Time), "%T") << "]"));
@@ -199,6 +247,10 @@ template <typename... Args> static std::string formatMessage(unsigned ThreadID,
   return Buffer.str();
 }
 
+/**
+ * Propagates a formatted log message to all loggers, or to the log buffer of the current thread.
+ * @param Message The log message to propagate.
+ */
 void logMessage(LogMessage &&Message);
 
 /**
@@ -7,13 +7,29 @@
 
 #include <llvm/IR/InstVisitor.h>
 
+#include <icarus/Analysis/Checkpoint.h>
 #include <icarus/Analysis/ProgramContext.h>
+#include <icarus/Analysis/StealingWorklist.h>
+#include <icarus/Analysis/TaskID.h>
+#include <icarus/Analysis/Worklist.h>
+#include <icarus/Passes/InstDispatch.h>
 #include <icarus/Passes/Pass.h>
 
 #include <icarus/Support/LLVMValue.h>
 #include <icarus/Support/Traits.h>
 
+#include <icarus/Threads/TaskGroup.h>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <queue>
+#include <random>
+#include <type_traits>
+#include <vector>
 
 namespace icarus::passes {
 
@@ -39,6 +55,11 @@ struct DefaultAnalysisIterator {
   }
 };
 
+/**
+ * Iterates the instructions of a function backwards, starting with its exit block. Functions without a
+ * unique exit block can not be interpreted this way, backward analyses on such functions should use the
+ * icarus::BackwardDataflow solver instead.
+ */
 struct ReverseAnalysisIterator {
 
   ReverseAnalysisIterator() = delete;
@@ -70,12 +91,109 @@ struct AnalysisContext : public llvm::InstVisitor<SubClass, RetTy> {
 protected:
   ProgramContext<Iterator> PC;
 
+  /* Contexts forked during the current quantum, scheduled by the pass afterwards */
+  std::vector<ProgramContext<Iterator>> Forks;
+
+  /* Basic blocks entered during the current quantum */
+  std::vector<const llvm::BasicBlock *> VisitedBlocks;
+
+  /* State of the generator for randomized choices of the analysis */
+  uint64_t RandomState = 0;
+
   /**
    * Creates a new AnalysisContext instance that inherits all methods from the llvm::InstVisitor class
    * template. The class is going to accept either a single llvm::BasicBlock or a llvm::Function which
    * contains an entry basic block for the analysis.
    */
   AnalysisContext() = default;
+
+  explicit AnalysisContext(const ProgramContext<Iterator> &PC) : PC(PC) {}
+
+  /**
+   * Schedule a forked program context (e.g. for the other successor of a branch instruction).
+   * @param Forked The forked program context.
+   */
+  void fork(ProgramContext<Iterator> &&Forked) {
+    Forks.push_back(std::move(Forked));
+  }
+
+  /**
+   * Returns the next number of the generator for randomized choices (splitmix64). Analyses must not use
+   * any other source of randomness, as the generator is seeded by the pass: In deterministic mode, the
+   * seed only depends on the --seed option and the task, so that each run makes the same choices.
+   * @return A pseudo-random 64-bit number.
+   */
+  uint64_t random() {
+    uint64_t Z = (RandomState += 0x9e3779b97f4a7c15ULL);
+    Z = (Z ^ (Z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    Z = (Z ^ (Z >> 27)) * 0x94d049bb133111ebULL;
+    return Z ^ (Z >> 31);
+  }
+
+public:
+  ProgramContext<Iterator> &getProgramContext() {
+    return PC;
+  }
+
+  void setProgramContext(ProgramContext<Iterator> &&Context) {
+    PC = std::move(Context);
+  }
+
+  ProgramContext<Iterator> takeProgramContext() {
+    return std::move(PC);
+  }
+
+  std::vector<ProgramContext<Iterator>> takeForks() {
+    return std::move(Forks);
+  }
+
+  std::vector<const llvm::BasicBlock *> takeVisitedBlocks() {
+    return std::move(VisitedBlocks);
+  }
+
+  void seedRandom(uint64_t Seed) {
+    RandomState = Seed;
+  }
+
+  /**
+   * Publish the results of the last quantum, e.g. by moving them from this context into the pass. The
+   * default implementation does nothing. In deterministic mode, this method is called from a single
+   * thread in the order of the task IDs. Otherwise, the workers call it concurrently after each quantum.
+   */
+  void commit() {}
+
+  /**
+   * Interpret the instructions of the current program context until either the quantum is exhausted or
+   * the call stack is empty. Call frames without remaining instructions are removed from the stack. The
+   * instructions are dispatched with the InstDispatchTable of the subclass, instructions for which the
+   * subclass does not override any visitor method are skipped.
+   * @param Quantum The maximum number of instructions to interpret.
+   * @return The number of interpreted instructions.
+   */
+  unsigned run(unsigned Quantum) {
+    unsigned Executed = 0;
+    const llvm::BasicBlock *LastBlock = nullptr;
+    while (Executed < Quantum && !PC.isStackEmpty()) {
+      auto &FC = PC.getCurrentFunctionStack();
+      if (!FC.hasNextInstruction()) {
+        PC.popFunctionContext();
+        continue;
+      }
+
+      llvm::Instruction *I = FC.nextInstruction();
+      if (I->getParent() != LastBlock)
+        VisitedBlocks.push_back(LastBlock = I->getParent());
+
+      if (auto Handler = InstDispatchTable<SubClass, RetTy>::Handlers[I->getOpcode()])
+        Handler(static_cast<SubClass &>(*this), *I);
+      ++Executed;
+    }
+
+    /* Do not reschedule contexts which only consist of finished call frames */
+    while (!PC.isStackEmpty() && !PC.getCurrentFunctionStack().hasNextInstruction())
+      PC.popFunctionContext();
+    return Executed;
+  }
 };
 
 /**
@@ -98,24 +216,267 @@ using enable_if_aiacontext = std::enable_if_t<is_template_base_of<AnalysisContex
 template <typename AIAContextImpl, typename Iterator, typename = enable_if_aiacontext<AIAContextImpl>>
 class AIAPassBase : public Pass {
 
+  /* Global memory after initialization, shared by all analysis tasks */
+  std::once_flag SnapshotFlag;
+  std::shared_ptr<const GlobalSnapshot> Snapshot;
+
+  /* Checkpoints of the pending program contexts */
+  std::unique_ptr<ModuleIndex> Index;
+  std::unique_ptr<Checkpointer> Checkpoints;
+
+  /* Pending program contexts of this pass */
+  Worklist<ProgramContext<Iterator>> Pending;
+
+  /* Deterministic execution (see runRounds) */
+  bool Deterministic = false;
+  uint64_t Seed = 0;
+
+  /**
+   * A program context in deterministic mode together with the identifier of its task, the number of
+   * tasks forked from it and the number of quanta it has been executed for.
+   */
+  struct DeterministicTask {
+    TaskID ID;
+    uint32_t NumForks;
+    uint64_t NumQuanta;
+    ProgramContext<Iterator> PC;
+
+    bool operator<(const DeterministicTask &Other) const {
+      return ID < Other.ID;
+    }
+  };
+
 protected:
+  /* Maximum number of tasks executed in a single round in deterministic mode */
+  static constexpr std::size_t RoundSize = 256;
+
   /**
-   * Helper function for scheduling an analysis context in the current pass. Depending on the template
-   * arguments and partial specialization, the context is then wrapped in a callable and placed either
-   * in a thread pool or a simple queue.
-   * @param AIAContext The analysis context to schedule for procession.
+   * Index the analyzed modules and set up the checkpoints according to the provided pass arguments.
+   * @param IPA The pass arguments containing the analyzed modules and the checkpoint options.
    */
-  void scheduleAnalysisContext(AIAContextImpl &AIAContext) {}
+  void initializeCheckpoints(PassArguments &IPA) {
+    Index = std::make_unique<ModuleIndex>(IPA.getModules());
+    Checkpoints = std::make_unique<Checkpointer>(*Index, IPA.getCheckpointFile(),
+                                                 std::chrono::seconds(IPA.getCheckpointInterval()));
+  }
 
-  void ProgramContextWorker(ProgramContext<Iterator> &PC) {
-    while (!PC.isStackEmpty()) {
-      auto &FC = PC.getCurrentFunctionStack();
-      llvm::Instruction &I = FC->nextInstruction();
-      ICARUS_INFO_WITH("iaa", "Interpreting: ", I);
-      AIAContextImpl::visit(I);
+  /**
+   * Write a checkpoint of the provided pending program contexts, if the checkpoint interval has passed.
+   * @param Contexts The range of pending program contexts (e.g. the contents of the worker queues).
+   */
+  template <typename Range> void checkpointContexts(const Range &Contexts) {
+    if (Checkpoints && Checkpoints->isDue() && !Checkpoints->save(Contexts))
+      ICARUS_WARN("Could not write checkpoint of ", Contexts.size(), " program contexts");
+  }
+
+  /**
+   * Restore the pending program contexts from the last checkpoint.
+   * @param Contexts The vector to append the restored program contexts to.
+   * @return True, if the program contexts have been restored.
+   */
+  bool restoreContexts(std::vector<ProgramContext<Iterator>> &Contexts) {
+    return Checkpoints && Checkpoints->restore(Contexts);
+  }
+
+  /**
+   * Returns the snapshot of the initialized global memory. The snapshot is created exactly once by the
+   * provided initializer (e.g. allocating the global values and executing the static constructors of
+   * all modules), even if this method is called concurrently from multiple analysis tasks.
+   * @tparam Initializer The type of the callable, accepting a ProgramContext<Iterator> reference.
+   * @param Init The callable which initializes the global memory of an empty program context.
+   * @return The snapshot of the global memory.
+   */
+  template <typename Initializer> const GlobalSnapshot &getGlobalSnapshot(Initializer &&Init) {
+    std::call_once(SnapshotFlag, [&]() {
+      ProgramContext<Iterator> PC;
+      Init(PC);
+      Snapshot = PC.takeSnapshot();
+    });
+    return *Snapshot;
+  }
+
+  /**
+   * Create a new program context for an analysis task from the snapshot of the initialized memory.
+   * @param Init The callable which initializes the global memory if no snapshot exists yet.
+   * @return The program context sharing its global memory with the snapshot.
+   */
+  template <typename Initializer> ProgramContext<Iterator> createProgramContext(Initializer &&Init) {
+    return ProgramContext<Iterator>(getGlobalSnapshot(std::forward<Initializer>(Init)));
+  }
+
+  /**
+   * Schedule a program context for execution in the current pass. The context is executed by one of the
+   * workers started in runWorklist, in the order given by the scheduling policy of the pass.
+   * @param PC The program context to schedule.
+   */
+  void scheduleAnalysisContext(ProgramContext<Iterator> &&PC) {
+    Pending.push(std::move(PC));
+  }
+
+  void setSchedulingPolicy(SchedulingPolicy Policy) {
+    Pending.setPolicy(Policy);
+  }
+
+  /**
+   * Enable or disable the deterministic execution of the scheduled program contexts (see runRounds).
+   * @param Enable True, if two runs of the pass should produce identical results and logs.
+   * @param NewSeed The seed for all randomized choices of the analysis.
+   */
+  void setDeterministic(bool Enable, uint64_t NewSeed = 0) {
+    Deterministic = Enable;
+    Seed = NewSeed;
+  }
+
+  /**
+   * Apply the scheduling options (policy and deterministic mode) from the provided pass arguments.
+   * @param IPA The pass arguments containing the scheduling options.
+   */
+  void initializeScheduling(PassArguments &IPA) {
+    setSchedulingPolicy(IPA.getSchedulingPolicy());
+    setDeterministic(IPA.isDeterministic(), IPA.getSeed());
+  }
+
+  /**
+   * Schedule all program contexts from the last checkpoint.
+   * @return True, if the program contexts have been restored.
+   */
+  bool resumeFromCheckpoint() {
+    std::vector<ProgramContext<Iterator>> Contexts;
+    if (!restoreContexts(Contexts))
+      return false;
+    for (ProgramContext<Iterator> &PC : Contexts)
+      scheduleAnalysisContext(std::move(PC));
+    return true;
+  }
+
+  /**
+   * Main loop of a single analysis worker. The worker repeatedly acquires a pending program context and
+   * interprets it for a quantum of instructions before it schedules the context again. This ensures that
+   * a single long-running context does not prevent other contexts (and checkpoints) from progressing.
+   * @tparam Factory The type of the callable creating the AnalysisContext of the worker.
+   * @tparam Queue The worklist type (i.e. Worklist or StealingWorklist::WorkerHandle).
+   * @param CreateContext The callable returning a new AIAContextImpl instance.
+   * @param Quantum The number of instructions to interpret before switching to another context.
+   * @param Contexts The worklist from which to acquire the program contexts.
+   */
+  template <typename Factory, typename Queue>
+  void runWorker(Factory &CreateContext, unsigned Quantum, Queue &Contexts) {
+    AIAContextImpl Context = CreateContext();
+    Context.seedRandom(std::random_device()());
+    ProgramContext<Iterator> PC;
+    while (Contexts.acquire(PC)) {
+      Context.setProgramContext(std::move(PC));
+      Context.run(Quantum);
+      Context.commit();
+
+      for (ProgramContext<Iterator> &Forked : Context.takeForks())
+        Contexts.push(std::move(Forked));
+      /* Only the shared worklist orders contexts by coverage, the deques of StealingWorklist are depth-first */
+      std::vector<const llvm::BasicBlock *> Visited = Context.takeVisitedBlocks();
+      if constexpr (std::is_same_v<Queue, decltype(Pending)>)
+        Contexts.recordCoverage(Visited);
+      if (!Context.getProgramContext().isStackEmpty())
+        Contexts.push(Context.takeProgramContext());
+      Contexts.release();
+
+      if (Checkpoints && Checkpoints->isDue())
+        Contexts.pause([&](const std::vector<ProgramContext<Iterator>> &Paused) { checkpointContexts(Paused); });
     }
   }
 
+  template <typename Factory> void runWorker(Factory &CreateContext, unsigned Quantum) {
+    runWorker(CreateContext, Quantum, Pending);
+  }
+
+  /**
+   * Execute all scheduled program contexts in deterministic rounds. Each context is assigned a TaskID:
+   * The scheduled contexts are numbered in order, forked contexts get the ID of the parent task extended
+   * by the number of the fork, and the remainder of a task keeps its ID. Each round executes the pending
+   * tasks with the smallest IDs (at most RoundSize) for a quantum in parallel, every task with its own
+   * AnalysisContext and generator seed. Afterwards, the logs, results (see AnalysisContext::commit) and
+   * new tasks are merged in the order of the task IDs by the current thread.
+   *
+   * The outcome of a round therefore neither depends on the number of workers nor on the order in which
+   * the tasks were executed. The scheduling policy is ignored, as the tasks are always executed in the
+   * order of their IDs (i.e. depth-first).
+   * @tparam Factory The type of the callable creating the AnalysisContext of a task.
+   * @tparam Executor The type of the callable running a worker function on multiple threads.
+   * @param CreateContext The callable returning a new AIAContextImpl instance. Called concurrently.
+   * @param Quantum The number of instructions to interpret per task and round.
+   * @param NumWorkers The number of workers to execute the tasks of a round.
+   * @param RunWorkers The callable which calls a worker function (with the index of the worker as its
+   *                   argument) on NumWorkers threads and returns once all of them have returned.
+   */
+  template <typename Factory, typename Executor>
+  void runRounds(Factory &CreateContext, unsigned Quantum, unsigned NumWorkers, Executor &&RunWorkers) {
+    std::vector<DeterministicTask> Tasks;
+    for (ProgramContext<Iterator> &PC : takeScheduledContexts())
+      Tasks.push_back({TaskID(Tasks.size()), 0, 0, std::move(PC)});
+
+    while (!Tasks.empty()) {
+      if (Checkpoints && Checkpoints->isDue()) {
+        std::vector<ProgramContext<Iterator>> Contexts;
+        for (const DeterministicTask &Task : Tasks)
+          Contexts.push_back(Task.PC.fork());
+        checkpointContexts(Contexts);
+      }
+
+      std::size_t NumTasks = std::min(Tasks.size(), RoundSize);
+      std::vector<std::optional<AIAContextImpl>> Contexts(NumTasks);
+      std::vector<std::vector<logger::LogMessage>> Logs(NumTasks);
+
+      std::atomic<std::size_t> NextTask = 0;
+      RunWorkers(NumWorkers, [&](unsigned) {
+        for (std::size_t N = NextTask++; N < NumTasks; N = NextTask++) {
+          logger::LogBuffer Buffer;
+          DeterministicTask &Task = Tasks[N];
+          AIAContextImpl &Context = Contexts[N].emplace(CreateContext());
+          Context.seedRandom(Task.ID.getStableHash(Seed, Task.NumQuanta++));
+          Context.setProgramContext(std::move(Task.PC));
+          Context.run(Quantum);
+          Logs[N] = Buffer.take();
+        }
+      });
+
+      std::vector<DeterministicTask> Next;
+      for (std::size_t N = 0; N < NumTasks; ++N) {
+        for (logger::LogMessage &Message : Logs[N])
+          logger::logMessage(std::move(Message));
+
+        DeterministicTask &Task = Tasks[N];
+        AIAContextImpl &Context = *Contexts[N];
+        Context.commit();
+        for (ProgramContext<Iterator> &Forked : Context.takeForks())
+          Next.push_back({Task.ID.getChild(Task.NumForks++), 0, 0, std::move(Forked)});
+        if (!Context.getProgramContext().isStackEmpty())
+          Next.push_back({std::move(Task.ID), Task.NumForks, Task.NumQuanta, Context.takeProgramContext()});
+      }
+
+      std::move(Tasks.begin() + NumTasks, Tasks.end(), std::back_inserter(Next));
+      std::sort(Next.begin(), Next.end());
+      Tasks = std::move(Next);
+    }
+  }
+
+  bool isDeterministic() const {
+    return Deterministic;
+  }
+
+  /**
+   * @return The scheduling policy of the worklist.
+   */
+  SchedulingPolicy getSchedulingPolicy() const {
+    return Pending.getPolicy();
+  }
+
+  /**
+   * Remove all scheduled program contexts, e.g. in order to distribute them to the workers.
+   * @return The scheduled program contexts.
+   */
+  std::vector<ProgramContext<Iterator>> takeScheduledContexts() {
+    return Pending.takeAll();
+  }
+
 public:
   /**
    * Creates a new abstract interpretation-based analysis pass with the provided AnalysisContext. With
@@ -141,7 +502,7 @@ template <typename AIAContextImpl, bool Threaded, typename Iterator> class Threa
 template <typename AIAContextImpl, typename Iterator>
 class ThreadedAIAPass<AIAContextImpl, false, Iterator> : public AIAPassBase<AIAContextImpl, Iterator> {
 
-  std::queue<std::unique_ptr<Task>> TaskQueue;
+  std::queue<TaskPtr> TaskQueue;
 
 public:
   /**
@@ -150,19 +511,24 @@ public:
    * as there is only one thread running during the analysis (logger threads not counted).
    * @tparam Func The type of the function to submit.
    * @tparam Args The variadic types of the function arguments.
-   * @tparam RetTy The return type of the function.
-   * @tparam PTask Type of the packaged task wrapping the callable function.
-   * @tparam TaskT The ThreadTask type with the template parameter from the function.
    * @param Function The function to execute in a thread pool task.
    * @param args The arguments to pass to the function.
    */
-  template <typename Func, typename... Args,
-            typename RetTy = std::invoke_result_t<std::decay_t<Func>, std::decay_t<Args>...>,
-            typename PTask = std::packaged_task<RetTy()>, typename TaskT = ThreadTask<PTask>>
-  void schedule(Func &&Function, Args &&...args) {
-    auto Task = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...);
-    std::packaged_task<RetTy()> PackagedTask(std::move(Task));
-    TaskQueue.emplace(std::make_unique<TaskT>(std::move(PackagedTask)));
+  template <typename Func, typename... Args> void schedule(Func &&Function, Args &&...args) {
+    TaskQueue.emplace(Task::create(std::bind(std::forward<Func>(Function), std::forward<Args>(args)...)));
+  }
+
+  /**
+   * Execute all scheduled program contexts in the current thread.
+   * @tparam Factory The type of the callable creating the AnalysisContext of the worker.
+   * @param CreateContext The callable returning a new AIAContextImpl instance.
+   * @param Quantum The number of instructions to interpret before switching to another context.
+   */
+  template <typename Factory> void runWorklist(Factory &&CreateContext, unsigned Quantum) {
+    if (this->isDeterministic())
+      this->runRounds(CreateContext, Quantum, 1, [](unsigned, auto &&Worker) { Worker(0); });
+    else
+      this->runWorker(CreateContext, Quantum);
   }
 };
 
@@ -174,7 +540,22 @@ public:
 template <typename AIAContextImpl, typename Iterator>
 class ThreadedAIAPass<AIAContextImpl, true, Iterator> : public AIAPassBase<AIAContextImpl, Iterator> {
 
-  ThreadPool TP;
+  /* The analysis runs in the default pool, which is also used by the logger for the thread IDs */
+  ThreadPool &TP = ThreadPool::getDefault();
+  StealingStatistics Statistics;
+
+  /**
+   * Run the provided worker function in all threads of the thread pool and in the current thread.
+   * @param NumWorkers The number of workers, including the current thread.
+   * @param Worker The function to call with the index of the worker.
+   */
+  template <typename Func> void runWorkers(unsigned NumWorkers, Func &&Worker) {
+    TaskGroup Workers(TP);
+    for (unsigned N = 1; N < NumWorkers; ++N)
+      Workers.run([&Worker, N]() { Worker(N); });
+    Worker(0);
+    Workers.wait();
+  }
 
 protected:
   /**
@@ -182,19 +563,77 @@ protected:
    * @param NumThreads The number of worker threads to initialize.
    */
   void initializeThreadPool(unsigned NumThreads) {
-    TP.initialize(NumThreads);
+    TP.doInitialize(NumThreads);
   }
 
 public:
   /**
-   * Schedule method for ThreadedAIAPass subclasses that support multithreading.
+   * Schedule method for ThreadedAIAPass subclasses that support multithreading. Posted tasks have no future
+   * to pass exceptions to, therefore exceptions thrown by the function are logged instead of terminating
+   * the worker thread.
    * @tparam Func The type of the function to submit.
    * @tparam Args The variadic types of the function arguments.
    * @param Function The function to execute in a thread pool task.
    * @param args The arguments to pass to the function.
    */
   template <typename Func, typename... Args> void schedule(Func &&Function, Args &&...args) {
-    TP.submit(Function, std::forward<Args>(args)...);
+    TP.doPost([Bound = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...)]() mutable {
+      try {
+        Bound();
+      } catch (const std::exception &E) {
+        ICARUS_FAIL("Scheduled task failed: ", E.what());
+      } catch (...) {
+        ICARUS_FAIL("Scheduled task failed with an unknown exception");
+      }
+    });
+  }
+
+  /**
+   * Execute all scheduled program contexts in all threads of the thread pool, including the current one.
+   * Each thread runs its own worker with a separate AnalysisContext. In deterministic mode, the contexts
+   * are executed in rounds instead (see AIAPassBase::runRounds).
+   *
+   * For depth-first scheduling, each worker has its own deque of program contexts and steals contexts
+   * from other workers if its deque is empty (see icarus::StealingWorklist). The remaining policies need
+   * a global order of all contexts, therefore all workers share a single worklist.
+   * @tparam Factory The type of the callable creating the AnalysisContext of the worker.
+   * @param CreateContext The callable returning a new AIAContextImpl instance. Called concurrently.
+   * @param Quantum The number of instructions to interpret before switching to another context.
+   */
+  template <typename Factory> void runWorklist(Factory &&CreateContext, unsigned Quantum) {
+    unsigned NumWorkers = TP.doGetThreadNum() + 1;
+    if (this->isDeterministic()) {
+      this->runRounds(CreateContext, Quantum, NumWorkers,
+                      [this](unsigned N, auto &&Worker) { runWorkers(N, std::forward<decltype(Worker)>(Worker)); });
+      return;
+    }
+
+    if (this->getSchedulingPolicy() != SchedulingPolicy::DFS) {
+      runWorkers(NumWorkers, [&](unsigned) { this->runWorker(CreateContext, Quantum); });
+      return;
+    }
+
+    StealingWorklist<ProgramContext<Iterator>> Contexts(NumWorkers);
+    unsigned Next = 0;
+    for (ProgramContext<Iterator> &PC : this->takeScheduledContexts())
+      Contexts.push(Next++ % NumWorkers, std::move(PC));
+
+    runWorkers(NumWorkers, [&](unsigned Worker) {
+      auto Handle = Contexts.getHandle(Worker);
+      this->runWorker(CreateContext, Quantum, Handle);
+    });
+
+    Statistics = Contexts.getStatistics();
+    ICARUS_INFO_WITH("aia", "Work stealing: ", Statistics.Pushed, " pushed, ", Statistics.Popped, " popped, ",
+                     Statistics.Stolen, " stolen, ", Statistics.FailedSteals, " failed steals, ",
+                     Statistics.Contended, " contended");
+  }
+
+  /**
+   * @return The counters of the last execution with work stealing.
+   */
+  const StealingStatistics &getStealingStatistics() const {
+    return Statistics;
   }
 };
 
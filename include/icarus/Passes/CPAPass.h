@@ -32,6 +32,8 @@ template <bool Threaded> class ThreadedCPAPass : public ThreadedAIAPass<CPAConte
 
 public:
   bool checkPassArguments(PassArguments &IPA) override {
+    this->initializeScheduling(IPA);
+    this->initializeCheckpoints(IPA);
     return true;
   }
 
@@ -13,6 +13,8 @@
 
 #include <icarus/Support/Traits.h>
 
+#include <limits>
+
 namespace icarus::passes {
 
 /**
@@ -22,21 +24,37 @@ namespace icarus::passes {
  * @tparam RetTy The return type of the individual llvm::InstVisitor methods.
  */
 template <typename AnalysisIterator, typename SubClass, typename RetTy = void>
-class EEAContext : public ExecutionEngine, public AnalysisContext<SubClass, RetTy> {
+class EEAContext : public ExecutionEngine, public AnalysisContext<AnalysisIterator, SubClass, RetTy> {
 
-  ProgramContext<AnalysisIterator> PC;
   ValueDelegate ExitValue;
 
 public:
   EEAContext(ProgramContext<AnalysisIterator> &PC, const llvm::DataLayout &DL)
-      : ExecutionEngine(DL), AnalysisContext<SubClass, RetTy>(), PC(PC) {}
+      : ExecutionEngine(DL), AnalysisContext<AnalysisIterator, SubClass, RetTy>(PC) {}
 
   /*
    * Virtual methods from ExecutionEngine
    */
 
+  /**
+   * Interpret the provided function to completion in the current program context. This is only supported
+   * for contexts without call frames (e.g. for static constructors while the global memory is initialized,
+   * see ExecutionEngine::executeCtors), contexts forked by the function are discarded.
+   * @param F The function to execute.
+   * @param ArgValues The values of the arguments of the function.
+   * @return The return value of the function, which is not tracked yet (i.e. an invalid delegate).
+   */
   ValueDelegate executeFunction(llvm::Function *F, llvm::ArrayRef<ValueDelegate> ArgValues) override {
-    return ValueDelegate();
+    if (F->isDeclaration() || !this->PC.isStackEmpty())
+      return ValueDelegate();
+
+    auto &FC = this->PC.pushFunctionContext(*F);
+    for (unsigned N = 0; N < ArgValues.size() && N < F->arg_size(); ++N)
+      FC.setValue(N, ArgValues[N]);
+    while (!this->PC.isStackEmpty())
+      this->run(std::numeric_limits<unsigned>::max());
+    this->takeForks();
+    return ExitValue;
   }
 
   virtual void *getPointerToNamedFunction(llvm::StringRef Name, bool AbortOnFailure = true) override {
@@ -37,6 +37,11 @@ struct IAAContext : EEAContext<DefaultAnalysisIterator, IAAContext, IAAContextRe
  */
 template <bool Threaded> class ThreadedIAAPass : public ThreadedEEAPass<IAAContext, Threaded, IAAContext::Iter> {
 
+  using Iter = IAAContext::Iter;
+
+  /* Number of instructions a worker interprets before it switches to another program context */
+  static constexpr unsigned Quantum = 1024;
+
   InputArguments IA;
 
   /**
@@ -50,14 +55,76 @@ template <bool Threaded> class ThreadedIAAPass : public ThreadedEEAPass<IAAConte
     from_json(JSON, IA, IM);
   }
 
+  /**
+   * Initialize the global memory of an empty program context: Allocate the global variables of all modules,
+   * store the values of the variables from the JSON arguments and execute the static constructors.
+   * @param IPA The reference to the class with the CLI options.
+   * @param DL The llvm::DataLayout of the analyzed program.
+   * @param PC The program context to initialize.
+   */
+  void initializeGlobalMemory(PassArguments &IPA, const llvm::DataLayout &DL, ProgramContext<Iter> &PC) {
+    for (llvm::Module *M : IPA.getModules())
+      PC.allocateGlobalValues(*M);
+
+    for (auto &[Name, VD] : IA.Variables) {
+      llvm::Value *GV = PC.getNamedValue(Name);
+      EngineValue *EV = GV ? PC.getMutableEngineValue(GV) : nullptr;
+      if (!EV || !VD.CVal || !EV->store(DL, 0, VD.CVal->getType(), VD.CVal))
+        ICARUS_WARN("Could not initialize global variable ", Name);
+    }
+
+    IAAContext Context(PC, DL);
+    for (llvm::Module *M : IPA.getModules())
+      Context.executeCtors(M);
+    PC = Context.takeProgramContext();
+  }
+
 protected:
   bool checkJSON(PassArguments &IPA) {
     return !IPA.getJSON().empty();
   }
 
+  /**
+   * Schedule a program context for each function of the JSON arguments. All contexts share the global
+   * memory initialized once (see AIAPassBase::getGlobalSnapshot).
+   * @param IPA The reference to the class with the CLI options.
+   * @param DL The llvm::DataLayout of the analyzed program.
+   */
+  void scheduleEntryContexts(PassArguments &IPA, const llvm::DataLayout &DL) {
+    auto Init = [&](ProgramContext<Iter> &PC) { initializeGlobalMemory(IPA, DL, PC); };
+    for (CallContext &CC : IA.Functions) {
+      if (!CC.Func || CC.Func->isDeclaration()) {
+        ICARUS_WARN("Skipping entry function without definition");
+        continue;
+      }
+
+      ProgramContext<Iter> PC = this->createProgramContext(Init);
+      auto &FC = PC.pushFunctionContext(*CC.Func);
+      for (auto &[Arg, CVal] : CC.Args)
+        FC.setValue(Arg, CVal);
+      this->scheduleAnalysisContext(std::move(PC));
+    }
+  }
+
 public:
+  /**
+   * Analyze the functions of the JSON arguments, or continue the analysis of the pending program contexts
+   * from the last checkpoint if the pass should resume.
+   * @param IPA The reference to the class with the CLI options.
+   * @return The exit code of the pass.
+   */
   int runAnalysisPass(PassArguments &IPA) override {
     parseJSONArguments(IPA);
+
+    const llvm::DataLayout &DL = IPA.getModuleAt(0)->getModule()->getDataLayout();
+    if (!IPA.shouldResume() || !this->resumeFromCheckpoint()) {
+      if (IPA.shouldResume())
+        ICARUS_WARN("Could not resume from checkpoint ", IPA.getCheckpointFile(), ", starting a new analysis");
+      scheduleEntryContexts(IPA, DL);
+    }
+
+    ProgramContext<Iter> Empty;
+    this->runWorklist([&]() { return IAAContext(Empty, DL); }, Quantum);
     return 0;
   }
 };
@@ -68,7 +135,11 @@ struct IAAPass : public ThreadedIAAPass<false> {
   static constexpr std::string_view NAME = "Input-Aware Analysis";
 
   bool checkPassArguments(PassArguments &IPA) override {
-    return ThreadedIAAPass<false>::checkJSON(IPA);
+    if (!ThreadedIAAPass<false>::checkJSON(IPA))
+      return false;
+    initializeScheduling(IPA);
+    initializeCheckpoints(IPA);
+    return true;
   }
 };
 
@@ -79,12 +150,16 @@ struct IATPass : public ThreadedIAAPass<true> {
 
 protected:
   using ThreadedIAAPass<true>::initializeThreadPool;
+  using ThreadedIAAPass<true>::initializeScheduling;
+  using ThreadedIAAPass<true>::initializeCheckpoints;
 
 public:
   bool checkPassArguments(PassArguments &IPA) override {
     if (!ThreadedIAAPass<true>::checkJSON(IPA))
       return false;
     initializeThreadPool(IPA.getNumThreads());
+    initializeScheduling(IPA);
+    initializeCheckpoints(IPA);
     return true;
   }
 };
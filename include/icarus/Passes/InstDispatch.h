@@ -0,0 +1,184 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_PASSES_INSTDISPATCH_H
+#define ICARUS_PASSES_INSTDISPATCH_H
+
+#include <llvm/IR/InstVisitor.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Instructions.h>
+
+#include <array>
+#include <type_traits>
+
+namespace icarus::passes {
+
+namespace detail {
+
+/**
+ * Returns the class in which the member of the provided member pointer type is declared.
+ */
+template <typename MemberPtr> struct member_class {};
+
+template <typename Member, typename Class> struct member_class<Member Class::*> {
+  using type = Class;
+};
+
+/**
+ * Determines whether the visitor method of the provided member pointer is declared in a subclass of the
+ * llvm::InstVisitor class template, i.e. whether the visitor method has been overridden.
+ */
+template <typename Visitor, typename RetTy, typename MemberPtr>
+using is_overridden =
+    std::bool_constant<!std::is_same_v<typename member_class<MemberPtr>::type, llvm::InstVisitor<Visitor, RetTy>>>;
+
+/**
+ * Declares the function overloads for detecting whether a visitor overrides the method visit##NAME. The
+ * functions are only used in unevaluated contexts. As they are not defined, the declarations may appear
+ * multiple times (e.g. for all binary operators, which share the class llvm::BinaryOperator). Methods
+ * that do not exist in the LLVM version at hand are never overridden.
+ */
+#define ICARUS_DECLARE_OVERRIDE(NAME)                                                                                  \
+  template <typename Visitor, typename RetTy>                                                                          \
+  auto overrides_visit##NAME(int) -> is_overridden<Visitor, RetTy, decltype(&Visitor::visit##NAME)>;                   \
+  template <typename Visitor, typename RetTy> std::false_type overrides_visit##NAME(...);
+
+#define ICARUS_OVERRIDES(NAME, Visitor, RetTy) decltype(detail::overrides_visit##NAME<Visitor, RetTy>(0))::value
+
+#define HANDLE_INST(NUM, OPCODE, CLASS)                                                                                \
+  ICARUS_DECLARE_OVERRIDE(OPCODE)                                                                                      \
+  ICARUS_DECLARE_OVERRIDE(CLASS)
+#include <llvm/IR/Instruction.def>
+
+/*
+ * The llvm::InstVisitor class declares multiple overloads of visit, so that the address of the method is
+ * only unambiguous if the visitor declares a single visit(llvm::Instruction &) method which hides them.
+ */
+ICARUS_DECLARE_OVERRIDE()
+
+/* Visitors of abstract instruction classes, reached from multiple opcodes */
+ICARUS_DECLARE_OVERRIDE(Instruction)
+ICARUS_DECLARE_OVERRIDE(Terminator)
+ICARUS_DECLARE_OVERRIDE(TerminatorInst)
+ICARUS_DECLARE_OVERRIDE(UnaryInstruction)
+ICARUS_DECLARE_OVERRIDE(CastInst)
+ICARUS_DECLARE_OVERRIDE(CmpInst)
+ICARUS_DECLARE_OVERRIDE(FuncletPadInst)
+ICARUS_DECLARE_OVERRIDE(CallBase)
+ICARUS_DECLARE_OVERRIDE(CallSite)
+
+/* Visitors of intrinsics, reached from call instructions */
+ICARUS_DECLARE_OVERRIDE(IntrinsicInst)
+ICARUS_DECLARE_OVERRIDE(DbgInfoIntrinsic)
+ICARUS_DECLARE_OVERRIDE(DbgVariableIntrinsic)
+ICARUS_DECLARE_OVERRIDE(DbgDeclareInst)
+ICARUS_DECLARE_OVERRIDE(DbgValueInst)
+ICARUS_DECLARE_OVERRIDE(DbgLabelInst)
+ICARUS_DECLARE_OVERRIDE(MemIntrinsic)
+ICARUS_DECLARE_OVERRIDE(MemSetInst)
+ICARUS_DECLARE_OVERRIDE(MemSetInlineInst)
+ICARUS_DECLARE_OVERRIDE(MemTransferInst)
+ICARUS_DECLARE_OVERRIDE(MemCpyInst)
+ICARUS_DECLARE_OVERRIDE(MemCpyInlineInst)
+ICARUS_DECLARE_OVERRIDE(MemMoveInst)
+ICARUS_DECLARE_OVERRIDE(VAStartInst)
+ICARUS_DECLARE_OVERRIDE(VAEndInst)
+ICARUS_DECLARE_OVERRIDE(VACopyInst)
+
+} // namespace detail
+
+/**
+ * Compile-time dispatch table of an llvm::InstVisitor subclass. The table contains one handler for each
+ * opcode, which calls the visitor method of the opcode (and therefore the usual delegation chain of the
+ * llvm::InstVisitor class). Opcodes for which the visitor overrides none of the methods in the delegation
+ * chain have no handler, so that instructions the analysis is not interested in can be skipped with a
+ * single lookup instead of the opcode switch and delegation chain of llvm::InstVisitor::visit.
+ *
+ * Overriding a visitor of an abstract instruction class (e.g. visitInstruction or visitCastInst) enables
+ * all handlers, overriding a visitor of an intrinsic enables the handler for calls. Visitors overriding
+ * visit(llvm::Instruction &) itself get a handler calling that method for all opcodes.
+ * @tparam Visitor The llvm::InstVisitor subclass.
+ * @tparam RetTy The return type of the visitor methods.
+ */
+template <typename Visitor, typename RetTy> class InstDispatchTable {
+
+public:
+  using Handler = RetTy (*)(Visitor &, llvm::Instruction &);
+
+  static constexpr unsigned NumOpcodes = llvm::Instruction::OtherOpsEnd;
+
+private:
+  static constexpr bool overridesAbstractVisitor() {
+    return ICARUS_OVERRIDES(Instruction, Visitor, RetTy) || ICARUS_OVERRIDES(Terminator, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(TerminatorInst, Visitor, RetTy) || ICARUS_OVERRIDES(UnaryInstruction, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(CastInst, Visitor, RetTy) || ICARUS_OVERRIDES(CmpInst, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(FuncletPadInst, Visitor, RetTy) || ICARUS_OVERRIDES(CallBase, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(CallSite, Visitor, RetTy);
+  }
+
+  static constexpr bool overridesIntrinsicVisitor() {
+    return ICARUS_OVERRIDES(IntrinsicInst, Visitor, RetTy) || ICARUS_OVERRIDES(DbgInfoIntrinsic, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(DbgVariableIntrinsic, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(DbgDeclareInst, Visitor, RetTy) || ICARUS_OVERRIDES(DbgValueInst, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(DbgLabelInst, Visitor, RetTy) || ICARUS_OVERRIDES(MemIntrinsic, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(MemSetInst, Visitor, RetTy) || ICARUS_OVERRIDES(MemSetInlineInst, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(MemTransferInst, Visitor, RetTy) || ICARUS_OVERRIDES(MemCpyInst, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(MemCpyInlineInst, Visitor, RetTy) || ICARUS_OVERRIDES(MemMoveInst, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(VAStartInst, Visitor, RetTy) || ICARUS_OVERRIDES(VAEndInst, Visitor, RetTy) ||
+           ICARUS_OVERRIDES(VACopyInst, Visitor, RetTy);
+  }
+
+  static constexpr std::array<Handler, NumOpcodes> createHandlers() {
+    constexpr bool All = overridesAbstractVisitor();
+    constexpr bool Intrinsics = overridesIntrinsicVisitor();
+    std::array<Handler, NumOpcodes> Handlers{};
+
+    /*
+     * Handlers installed for opcodes whose own visitor methods are not overridden (see All and Intrinsics)
+     * end in llvm::InstVisitor::visitInstruction, which does not return a value. Visitors returning a value
+     * therefore have to override visitInstruction in this case.
+     */
+    static_assert(std::is_void_v<RetTy> || ICARUS_OVERRIDES(Instruction, Visitor, RetTy) ||
+                      ICARUS_OVERRIDES(, Visitor, RetTy) || !(All || Intrinsics),
+                  "Visitors returning a value must override visitInstruction if they override the visitor of an "
+                  "abstract instruction class or intrinsic");
+
+    /* Visitors which intercept all instructions themselves still need to see all of them */
+    if constexpr (ICARUS_OVERRIDES(, Visitor, RetTy)) {
+      for (Handler &H : Handlers)
+        H = [](Visitor &V, llvm::Instruction &I) -> RetTy { return V.visit(I); };
+      return Handlers;
+    }
+
+    /* Opcodes reserved for passes never appear in analyzed modules and have no handler */
+#define HANDLE_USER_INST(NUM, OPCODE, CLASS)
+#define HANDLE_INST(NUM, OPCODE, CLASS)                                                                                \
+  if constexpr (All || ICARUS_OVERRIDES(OPCODE, Visitor, RetTy) || ICARUS_OVERRIDES(CLASS, Visitor, RetTy) ||          \
+                (NUM == llvm::Instruction::Call && Intrinsics))                                                        \
+    Handlers[NUM] = [](Visitor &V, llvm::Instruction &I) -> RetTy {                                                    \
+      return V.visit##OPCODE(static_cast<llvm::CLASS &>(I));                                                           \
+    };
+#include <llvm/IR/Instruction.def>
+
+    return Handlers;
+  }
+
+public:
+  static constexpr std::array<Handler, NumOpcodes> Handlers = createHandlers();
+
+  /**
+   * @param Opcode The opcode of an instruction.
+   * @return True, if the visitor handles instructions with the provided opcode.
+   */
+  static constexpr bool isHandled(unsigned Opcode) {
+    return Opcode < NumOpcodes && Handlers[Opcode] != nullptr;
+  }
+};
+
+#undef ICARUS_OVERRIDES
+#undef ICARUS_DECLARE_OVERRIDE
+
+} // namespace icarus::passes
+
+#endif // ICARUS_PASSES_INSTDISPATCH_H
@@ -11,6 +11,8 @@
 
 #include <icarus/ADT/Container.h>
 
+#include <icarus/Analysis/SchedulingPolicy.h>
+
 #include <icarus/Support/Namespaces.h>
 
 #include <nlohmann/json.hpp>
@@ -50,6 +52,9 @@ class IcarusModule {
   llvm::LLVMContext Context;
   std::unique_ptr<llvm::Module> IRModule;
 
+  /* NUMA node of the thread which parsed the module and allocated its memory */
+  unsigned Node;
+
 public:
   explicit IcarusModule(std::string const &FilePath);
 
@@ -58,6 +63,11 @@ public:
   llvm::Module *getModule() const;
   llvm::SMDiagnostic &getDiagnostics();
 
+  /**
+   * @return The NUMA node of the thread which loaded the module, to analyze it preferably on the same node.
+   */
+  unsigned getNode() const;
+
   llvm::Type *parseType(const nlohmann::json &JSON);
   llvm::Constant *parseConstant(std::string const &Asm);
   llvm::Constant *parseConstant(const nlohmann::json &JSON, llvm::Type *T);
@@ -79,12 +89,30 @@ class PassArguments {
   unsigned NumThreads;
   ModuleVector Modules;
 
-  nlohmann::json JSON;
+  /* Checkpoint options for long-running analyses */
+  std::string CheckpointFile;
+  unsigned CheckpointInterval = 0;
+  bool Resume = false;
 
-  void insertModule(std::string const &FilePath);
+  SchedulingPolicy Policy = SchedulingPolicy::DFS;
+
+  /* Options for reproducible results of threaded analyses */
+  bool Deterministic = false;
+  uint64_t Seed = 0;
+
+  nlohmann::json JSON;
 
 public:
-  PassArguments(std::string const &FileArg, std::string const &JSONArg, unsigned NumThreads);
+  /**
+   * Load the modules of the input file and parse the JSON file.
+   * @param FileArg The path of an LLVM file, or of a text file with the paths of multiple LLVM files.
+   * @param JSONArg The path of the JSON file with the pass-specific arguments, or an empty string.
+   * @param NumThreads The number of threads of the analysis.
+   * @param NumLoadThreads The number of threads (including the current one) loading the modules in parallel.
+   *                       The additional threads belong to a separate pool, which exits after the loading.
+   */
+  PassArguments(std::string const &FileArg, std::string const &JSONArg, unsigned NumThreads,
+                unsigned NumLoadThreads = 1);
 
   std::string getFile() const;
   std::string getJSON() const;
@@ -92,6 +120,31 @@ public:
   unsigned int getNumFiles() const;
   nlohmann::json &getJSONObject();
 
+  /**
+   * Set the options for periodically writing checkpoints of the analysis state.
+   * @param File The path of the checkpoint file, an empty path disables checkpoints.
+   * @param Interval The minimum number of seconds between two checkpoints.
+   * @param Resume True, if the analysis should resume from the checkpoint file.
+   */
+  void setCheckpointOptions(std::string const &File, unsigned Interval, bool Resume);
+
+  std::string getCheckpointFile() const;
+  unsigned getCheckpointInterval() const;
+  bool shouldResume() const;
+
+  void setSchedulingPolicy(SchedulingPolicy NewPolicy);
+  SchedulingPolicy getSchedulingPolicy() const;
+
+  /**
+   * Set the options for the deterministic execution of analyses.
+   * @param Enable True, if two runs with the same number of threads should produce identical output.
+   * @param Seed The seed for all randomized choices of the analysis.
+   */
+  void setDeterministicOptions(bool Enable, uint64_t Seed);
+
+  bool isDeterministic() const;
+  uint64_t getSeed() const;
+
   /**
    * Get the IcarusModule instance for the provided file name. This method does only look
    * for the file name, and not the entire path. If there are multiple files registered that
@@ -114,6 +167,11 @@ public:
 
   iterator begin();
   iterator end();
+
+  /**
+   * @return The llvm::Module instances of all registered files in insertion order.
+   */
+  std::vector<llvm::Module *> getModules();
 };
 
 } // namespace icarus
@@ -0,0 +1,175 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_PASSES_SPARSEDATAFLOW_H
+#define ICARUS_PASSES_SPARSEDATAFLOW_H
+
+#include <llvm/ADT/BitVector.h>
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/PostOrderIterator.h>
+
+#include <icarus/Analysis/FunctionSlots.h>
+
+#include <icarus/Passes/AIAPass.h>
+#include <icarus/Passes/InstDispatch.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace icarus::passes {
+
+template <typename ContextT> class SparseDataflow;
+
+/**
+ * Base class for analyses solved by the SparseDataflow solver. The subclass describes the lattice and
+ * the transfer functions of the analysis:
+ *
+ *   LatticeT getBottom();
+ *     The initial state of all instructions.
+ *   LatticeT getValueState(llvm::Value &V);
+ *     The state of values not computed by instructions of the function (arguments, constants, globals).
+ *   bool join(LatticeT &State, const LatticeT &Other);
+ *     Join the other state into the provided state, return true if the state changed. The height of the
+ *     lattice must be finite for the solver to terminate.
+ *   LatticeT visit...(...);
+ *     The visitor methods of llvm::InstVisitor are the transfer functions: They return the new state of
+ *     the instruction, reading the states of its operands with getState. Instructions without visitor
+ *     keep their initial state.
+ * @tparam SubClass The subclass that specializes this template.
+ * @tparam LatticeT The type of the lattice elements.
+ * @tparam Iterator The instruction iterator of the underlying AnalysisContext.
+ */
+template <typename SubClass, typename LatticeT, typename Iterator = DefaultAnalysisIterator>
+struct SparseAnalysisContext : public AnalysisContext<Iterator, SubClass, LatticeT> {
+
+  using LatticeType = LatticeT;
+
+private:
+  friend class SparseDataflow<SubClass>;
+
+  SparseDataflow<SubClass> *Solver = nullptr;
+
+protected:
+  /**
+   * @param V The operand of the instruction currently visited.
+   * @return The current state of the operand.
+   */
+  LatticeT getState(llvm::Value *V) {
+    return Solver->getState(V);
+  }
+};
+
+/**
+ * Sparse dataflow solver over the SSA graph of a function. Instead of iterating over all instructions of
+ * all blocks until nothing changes, the solver only re-evaluates the users of an instruction whenever the
+ * state of the instruction changed. The transfer functions are called through the InstDispatchTable of
+ * the analysis, so instructions the analysis does not handle are never evaluated.
+ *
+ * States of arguments and instructions are stored in arrays indexed by the FunctionSlots of the function,
+ * states of other values (constants and globals) are computed once and cached.
+ * @tparam ContextT The SparseAnalysisContext subclass describing the analysis.
+ */
+template <typename ContextT> class SparseDataflow {
+
+public:
+  using LatticeT = typename ContextT::LatticeType;
+
+private:
+  ContextT &Context;
+  llvm::Function &F;
+  const FunctionSlots &Slots;
+
+  std::vector<LatticeT> States;
+  llvm::DenseMap<const llvm::Value *, LatticeT> ValueStates;
+
+  std::vector<llvm::Instruction *> Worklist;
+  llvm::BitVector OnWorklist;
+  unsigned NumTransfers = 0;
+
+  void push(llvm::Instruction *I) {
+    int Slot = Slots.getSlot(I);
+    if (Slot < 0 || OnWorklist.test(Slot))
+      return;
+    OnWorklist.set(Slot);
+    Worklist.push_back(I);
+  }
+
+public:
+  /**
+   * Prepare the solver for the provided function. Arguments start with the state from getValueState of
+   * the analysis, instructions with the bottom element.
+   * @param Context The analysis describing the lattice and transfer functions.
+   * @param F The function to analyze, must not be a declaration.
+   */
+  SparseDataflow(ContextT &Context, llvm::Function &F)
+      : Context(Context), F(F), Slots(FunctionSlots::get(F)), OnWorklist(Slots.getNumSlots()) {
+    States.reserve(Slots.getNumSlots());
+    for (unsigned Slot = 0; Slot < Slots.getNumSlots(); ++Slot) {
+      llvm::Value *V = Slots.getValue(Slot);
+      States.push_back(llvm::isa<llvm::Argument>(V) ? Context.getValueState(*V) : Context.getBottom());
+    }
+  }
+
+  /**
+   * Compute the fixpoint of the analysis. All instructions of blocks reachable from the entry block are
+   * evaluated once in reverse post-order, afterwards only the users of changed instructions.
+   * @return The number of evaluated transfer functions.
+   */
+  unsigned solve() {
+    Context.Solver = this;
+
+    llvm::ReversePostOrderTraversal<llvm::Function *> RPOT(&F);
+    for (llvm::BasicBlock *BB : RPOT)
+      for (llvm::Instruction &I : *BB)
+        push(&I);
+
+    /* The worklist is a stack, reverse it to start with the entry block */
+    std::reverse(Worklist.begin(), Worklist.end());
+
+    while (!Worklist.empty()) {
+      llvm::Instruction *I = Worklist.back();
+      Worklist.pop_back();
+      unsigned Slot = Slots.getSlot(I);
+      OnWorklist.reset(Slot);
+
+      auto Handler = InstDispatchTable<ContextT, LatticeT>::Handlers[I->getOpcode()];
+      if (!Handler)
+        continue;
+
+      ++NumTransfers;
+      if (!Context.join(States[Slot], Handler(Context, *I)))
+        continue;
+
+      for (llvm::User *U : I->users())
+        if (auto *UserInst = llvm::dyn_cast<llvm::Instruction>(U))
+          push(UserInst);
+    }
+
+    Context.Solver = nullptr;
+    return NumTransfers;
+  }
+
+  /**
+   * @param V Any value used in the analyzed function.
+   * @return The current state of the value.
+   */
+  LatticeT getState(llvm::Value *V) {
+    int Slot = Slots.getSlot(V);
+    if (Slot >= 0)
+      return States[Slot];
+
+    auto It = ValueStates.find(V);
+    if (It == ValueStates.end())
+      It = ValueStates.try_emplace(V, Context.getValueState(*V)).first;
+    return It->second;
+  }
+
+  unsigned getNumTransfers() const {
+    return NumTransfers;
+  }
+};
+
+} // namespace icarus::passes
+
+#endif // ICARUS_PASSES_SPARSEDATAFLOW_H
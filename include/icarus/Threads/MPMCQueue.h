@@ -0,0 +1,234 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_THREADS_MPMCQUEUE_H
+#define ICARUS_THREADS_MPMCQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+namespace icarus {
+
+/**
+ * Bounded lock-free queue for multiple producers and multiple consumers, based on the ring buffer of Dmitry
+ * Vyukov. Each cell of the ring buffer carries a sequence number, which tells producers and consumers at a
+ * given position whether the cell is free or holds an element of the current round. Producers and consumers
+ * claim positions with a single compare-and-swap on the enqueue or dequeue position, and do not contend with
+ * each other unless the queue is empty or full.
+ *
+ * The class provides the same interface as ThreadSafeQueue and can replace it as base class of a queue. The
+ * blocking methods only fall back to a mutex and condition variable if the queue is empty (for consumers) or
+ * full (for producers), otherwise no lock is taken.
+ * @tparam SubClass The subclass that might provide custom methods overriding default behavior.
+ * @tparam T The type of the elements stored in the queue.
+ * @tparam Capacity The maximum number of elements in the queue, must be a power of two.
+ */
+template <typename SubClass, typename T, std::size_t Capacity = 1024> class MPMCQueue {
+
+  static_assert(Capacity >= 2 && !(Capacity & (Capacity - 1)), "Capacity of MPMCQueue must be a power of two");
+
+  static constexpr std::size_t Mask = Capacity - 1;
+
+  struct Cell {
+    std::atomic<std::size_t> Sequence;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+    T *get() {
+      return std::launder(reinterpret_cast<T *>(&Storage));
+    }
+  };
+
+  std::unique_ptr<Cell[]> Cells;
+
+  alignas(64) std::atomic<std::size_t> EnqueuePos = 0;
+  alignas(64) std::atomic<std::size_t> DequeuePos = 0;
+
+  /* Blocking slow path, only used by threads waiting for an element or a free cell */
+  alignas(64) std::atomic_bool Status = {true};
+  std::atomic_uint WaitingConsumers = 0;
+  std::atomic_uint WaitingProducers = 0;
+  std::mutex Mutex;
+  std::condition_variable NotEmpty;
+  std::condition_variable NotFull;
+
+  /**
+   * Wakes up a thread waiting on the provided condition. The fence orders the preceding publication of
+   * a cell before reading the number of waiting threads, which in turn increment the counter before they
+   * check the cells again (see wait).
+   */
+  void wake(std::atomic_uint &Waiting, std::condition_variable &Condition) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (Waiting.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> Lock(Mutex);
+      Condition.notify_one();
+    }
+  }
+
+  template <typename Pred> void wait(std::atomic_uint &Waiting, std::condition_variable &Condition, Pred &&Ready) {
+    std::unique_lock<std::mutex> Lock(Mutex);
+    Waiting.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Condition.wait(Lock, [&]() { return Ready() || !Status; });
+    Waiting.fetch_sub(1);
+  }
+
+  bool canPop() const {
+    std::size_t Pos = DequeuePos.load(std::memory_order_relaxed);
+    return Cells[Pos & Mask].Sequence.load(std::memory_order_acquire) == Pos + 1;
+  }
+
+  bool canPush() const {
+    std::size_t Pos = EnqueuePos.load(std::memory_order_relaxed);
+    return Cells[Pos & Mask].Sequence.load(std::memory_order_acquire) == Pos;
+  }
+
+public:
+  MPMCQueue() : Cells(new Cell[Capacity]) {
+    for (std::size_t Pos = 0; Pos < Capacity; ++Pos)
+      Cells[Pos].Sequence.store(Pos, std::memory_order_relaxed);
+  }
+
+  MPMCQueue(const MPMCQueue &Other) = delete;
+  MPMCQueue &operator=(const MPMCQueue &Other) = delete;
+
+  /**
+   * Destroys all remaining elements, after notifying all waiting threads.
+   */
+  ~MPMCQueue() {
+    invalidate();
+    for (T Element; tryPop(Element);)
+      ;
+  }
+
+  /**
+   * Adds an element at the end of the queue if the queue is not full. The element is only moved from if
+   * it has been added.
+   * @param t The element to add.
+   * @return True, if the element has been added.
+   */
+  bool tryPush(T &&t) {
+    Cell *C;
+    std::size_t Pos = EnqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      C = &Cells[Pos & Mask];
+      std::size_t Sequence = C->Sequence.load(std::memory_order_acquire);
+      auto Diff = static_cast<std::intptr_t>(Sequence) - static_cast<std::intptr_t>(Pos);
+      if (!Diff && EnqueuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+        break;
+      if (Diff < 0)
+        return false;
+      if (Diff > 0)
+        Pos = EnqueuePos.load(std::memory_order_relaxed);
+    }
+
+    new (&C->Storage) T(std::move(t));
+    C->Sequence.store(Pos + 1, std::memory_order_release);
+    wake(WaitingConsumers, NotEmpty);
+    return true;
+  }
+
+  /**
+   * Removes the first element of the queue if the queue is not empty.
+   * @param t The reference to the variable where the first element of the queue is assigned to.
+   * @return True, if the element was successfully removed and assigned to the reference.
+   */
+  bool tryPop(T &t) {
+    Cell *C;
+    std::size_t Pos = DequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      C = &Cells[Pos & Mask];
+      std::size_t Sequence = C->Sequence.load(std::memory_order_acquire);
+      auto Diff = static_cast<std::intptr_t>(Sequence) - static_cast<std::intptr_t>(Pos + 1);
+      if (!Diff && DequeuePos.compare_exchange_weak(Pos, Pos + 1, std::memory_order_relaxed))
+        break;
+      if (Diff < 0)
+        return false;
+      if (Diff > 0)
+        Pos = DequeuePos.load(std::memory_order_relaxed);
+    }
+
+    T *Element = C->get();
+    t = std::move(*Element);
+    Element->~T();
+    C->Sequence.store(Pos + Capacity, std::memory_order_release);
+    wake(WaitingProducers, NotFull);
+    return true;
+  }
+
+  /**
+   * Adds an element at the end of the queue. If the queue is full, the thread blocks until an element has
+   * been removed. If the queue is full and has been invalidated, the element is discarded.
+   * @param t The element to push to the end of the queue.
+   */
+  void push(T &&t) {
+    while (!tryPush(std::move(t))) {
+      if (!Status)
+        return;
+      wait(WaitingProducers, NotFull, [&]() { return canPush(); });
+    }
+  }
+
+  /**
+   * Removes the first element from the queue. The caller is responsible for checking if the queue
+   * contains any elements before calling this method.
+   */
+  void pop() {
+    T t;
+    tryPop(t);
+  }
+
+  /**
+   * Removes the first element from the queue and returns it if the queue is not empty. If it is empty,
+   * the thread blocks until at least one element is inside the queue or the queue has been invalidated.
+   * @param t The reference to the variable where the first element of the queue is assigned to.
+   * @return True, if the element was successfully removed and assigned to the reference.
+   */
+  bool pop(T &t) {
+    for (;;) {
+      if (!Status)
+        return false;
+      if (tryPop(t))
+        return true;
+      wait(WaitingConsumers, NotEmpty, [&]() { return canPop(); });
+    }
+  }
+
+  /**
+   * @return The number of elements in the queue. Only exact if no other thread modifies the queue.
+   */
+  std::size_t size() const {
+    std::size_t Dequeued = DequeuePos.load(std::memory_order_relaxed);
+    std::size_t Enqueued = EnqueuePos.load(std::memory_order_relaxed);
+    return Enqueued > Dequeued ? Enqueued - Dequeued : 0;
+  }
+
+  bool empty() const {
+    return !canPop();
+  }
+
+  static constexpr std::size_t capacity() {
+    return Capacity;
+  }
+
+  /**
+   * Invalidates the queue and subsequently notifies all sleeping threads of this change. Blocking calls
+   * of pop return false afterwards.
+   */
+  void invalidate() {
+    std::lock_guard<std::mutex> Lock(Mutex);
+    Status = false;
+    NotEmpty.notify_all();
+    NotFull.notify_all();
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_THREADS_MPMCQUEUE_H
@@ -0,0 +1,328 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_THREADS_TASK_H
+#define ICARUS_THREADS_TASK_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace icarus {
+
+/**
+ * Allocator for the small, short-lived objects of the thread pool: Task nodes and the shared state of
+ * TaskFuture objects. Requests up to BlockSize bytes are served from fixed-size blocks, which are cached
+ * per thread and exchanged with a global list in batches. Since tasks are usually allocated by one thread
+ * and freed by another one, the batches move free blocks from the executing threads back to submitting
+ * threads, without taking a lock for every block. Larger requests are forwarded to operator new.
+ */
+struct TaskAllocator {
+  static constexpr std::size_t BlockSize = 64;
+  static constexpr unsigned BatchSize = 64;
+
+  /**
+   * @param Size The number of bytes to allocate.
+   * @return Memory of at least the provided size, aligned for std::max_align_t.
+   */
+  static void *allocate(std::size_t Size);
+
+  /**
+   * @param Ptr The memory returned by TaskAllocator::allocate.
+   * @param Size The number of bytes passed to TaskAllocator::allocate.
+   */
+  static void deallocate(void *Ptr, std::size_t Size);
+};
+
+/**
+ * Type-erased thread pool task of a single block of the TaskAllocator. Callables fitting into the inline
+ * storage of the task (e.g. lambdas capturing a few references) are stored in place, only larger callables
+ * are allocated separately. Tasks are created with Task::create and destroyed by either Task::run or
+ * Task::discard, the latter being called by TaskPtr.
+ */
+class Task {
+
+  static constexpr std::size_t InlineSize = TaskAllocator::BlockSize - alignof(std::max_align_t);
+
+  /* Runs the callable if the flag is set, then destroys it */
+  using OperationFn = void (*)(Task &, bool);
+
+  OperationFn Operation;
+  alignas(std::max_align_t) unsigned char Storage[InlineSize];
+
+  template <typename Func> explicit Task(Func &&Function) {
+    using FuncT = std::decay_t<Func>;
+    if constexpr (sizeof(FuncT) <= InlineSize && alignof(FuncT) <= alignof(std::max_align_t)) {
+      new (Storage) FuncT(std::forward<Func>(Function));
+      Operation = [](Task &T, bool Run) {
+        FuncT &Callable = *std::launder(reinterpret_cast<FuncT *>(T.Storage));
+        if (Run)
+          Callable();
+        Callable.~FuncT();
+      };
+    } else {
+      new (Storage) FuncT *(new FuncT(std::forward<Func>(Function)));
+      Operation = [](Task &T, bool Run) {
+        FuncT *Callable = *std::launder(reinterpret_cast<FuncT **>(T.Storage));
+        if (Run)
+          (*Callable)();
+        delete Callable;
+      };
+    }
+  }
+
+  static void finish(Task *T, bool Run) {
+    T->Operation(*T, Run);
+    T->~Task();
+    TaskAllocator::deallocate(T, sizeof(Task));
+  }
+
+public:
+  Task(const Task &Other) = delete;
+  Task &operator=(const Task &Other) = delete;
+
+  /**
+   * @tparam Func The type of the callable, which is called without arguments.
+   * @param Function The callable to execute in the task.
+   * @return The new task.
+   */
+  template <typename Func> static Task *create(Func &&Function) {
+    return new (TaskAllocator::allocate(sizeof(Task))) Task(std::forward<Func>(Function));
+  }
+
+  /**
+   * Executes the callable of the task and destroys the task afterwards.
+   * @param T The task to execute.
+   */
+  static void run(Task *T) {
+    finish(T, true);
+  }
+
+  /**
+   * Destroys the task without executing its callable.
+   * @param T The task to destroy.
+   */
+  static void discard(Task *T) {
+    finish(T, false);
+  }
+};
+
+static_assert(sizeof(Task) == TaskAllocator::BlockSize, "Task must fit into a single block");
+
+/**
+ * Deleter for owning task pointers, which discards tasks that have not been executed.
+ */
+struct TaskDeleter {
+  void operator()(Task *T) const {
+    Task::discard(T);
+  }
+};
+
+using TaskPtr = std::unique_ptr<Task, TaskDeleter>;
+
+namespace detail {
+
+/**
+ * The part of the shared state of a TaskFuture which does not depend on the result type. The state is
+ * referenced by the future and by the promise of the task, and freed by the last of them.
+ */
+class FutureStateBase {
+
+  static constexpr uint32_t Ready = 1;
+  static constexpr uint32_t Waiting = 2;
+
+  std::atomic<uint32_t> Status = 0;
+  std::exception_ptr Exception;
+
+protected:
+  std::atomic<uint32_t> References = 2;
+
+  /**
+   * Marks the state as ready and wakes up all threads waiting for it.
+   */
+  void setReady();
+
+  void rethrow() const {
+    if (Exception)
+      std::rethrow_exception(Exception);
+  }
+
+public:
+  bool isReady() const {
+    return Status.load(std::memory_order_acquire) & Ready;
+  }
+
+  /**
+   * Blocks until the state is ready. Waiting threads are parked on one of a few condition variables
+   * shared by all states, so that the state itself only needs a single word for synchronization.
+   */
+  void wait();
+
+  void setException(std::exception_ptr E) {
+    Exception = std::move(E);
+    setReady();
+  }
+};
+
+template <typename RetTy> class FutureState : public FutureStateBase {
+
+  static_assert(!std::is_reference_v<RetTy>, "Tasks must not return references");
+
+  using StorageT = std::conditional_t<std::is_void_v<RetTy>, bool, RetTy>;
+
+  std::optional<StorageT> Value;
+
+public:
+  static FutureState *create() {
+    return new (TaskAllocator::allocate(sizeof(FutureState))) FutureState();
+  }
+
+  /**
+   * Drops one reference to the state and frees the state if it was the last one.
+   * @param State The state to release.
+   */
+  static void release(FutureState *State) {
+    if (State->References.fetch_sub(1, std::memory_order_acq_rel) != 1)
+      return;
+    State->~FutureState();
+    TaskAllocator::deallocate(State, sizeof(FutureState));
+  }
+
+  /**
+   * Calls the provided function and stores its result or the exception it has thrown.
+   * @param Function The function to call.
+   */
+  template <typename Func> void run(Func &&Function) {
+    std::exception_ptr E;
+    try {
+      if constexpr (std::is_void_v<RetTy>)
+        Function();
+      else
+        Value.emplace(Function());
+    } catch (...) {
+      E = std::current_exception();
+    }
+
+    /* The state is published after the handler released the thrown exception */
+    if (E)
+      setException(std::move(E));
+    else
+      setReady();
+  }
+
+  RetTy get() {
+    wait();
+    rethrow();
+    if constexpr (!std::is_void_v<RetTy>)
+      return std::move(*Value);
+  }
+};
+
+/**
+ * The producer side of a TaskFuture, owned by the task. If the task is discarded before it was executed,
+ * the future receives a std::future_error with std::future_errc::broken_promise, as for std::packaged_task.
+ */
+template <typename RetTy> class TaskPromise {
+
+  FutureState<RetTy> *State;
+
+public:
+  explicit TaskPromise(FutureState<RetTy> *State) : State(State) {}
+  TaskPromise(TaskPromise &&Other) noexcept : State(std::exchange(Other.State, nullptr)) {}
+  TaskPromise(const TaskPromise &Other) = delete;
+  TaskPromise &operator=(const TaskPromise &Other) = delete;
+  TaskPromise &operator=(TaskPromise &&Other) = delete;
+
+  ~TaskPromise() {
+    if (!State)
+      return;
+    State->setException(std::make_exception_ptr(std::future_error(std::future_errc::broken_promise)));
+    FutureState<RetTy>::release(State);
+  }
+
+  template <typename Func> void run(Func &&Function) {
+    State->run(Function);
+    FutureState<RetTy>::release(std::exchange(State, nullptr));
+  }
+};
+
+} // namespace detail
+
+/**
+ * Future of a task submitted to the ThreadPool. It provides the subset of the std::future interface used
+ * in icarus, but its shared state is allocated by the TaskAllocator instead of the heap.
+ * @tparam RetTy The return type of the task.
+ */
+template <typename RetTy> class TaskFuture {
+
+  detail::FutureState<RetTy> *State = nullptr;
+
+public:
+  TaskFuture() = default;
+  explicit TaskFuture(detail::FutureState<RetTy> *State) : State(State) {}
+  TaskFuture(TaskFuture &&Other) noexcept : State(std::exchange(Other.State, nullptr)) {}
+  TaskFuture(const TaskFuture &Other) = delete;
+  TaskFuture &operator=(const TaskFuture &Other) = delete;
+
+  TaskFuture &operator=(TaskFuture &&Other) noexcept {
+    if (this != &Other) {
+      reset();
+      State = std::exchange(Other.State, nullptr);
+    }
+    return *this;
+  }
+
+  ~TaskFuture() {
+    reset();
+  }
+
+  /**
+   * @return True, if the future refers to a shared state, i.e. TaskFuture::get has not been called yet.
+   */
+  bool valid() const {
+    return State;
+  }
+
+  bool isReady() const {
+    return State->isReady();
+  }
+
+  /**
+   * Blocks until the task has finished.
+   */
+  void wait() const {
+    State->wait();
+  }
+
+  /**
+   * Blocks until the task has finished and returns its result, or rethrows the exception thrown by the
+   * task. Afterwards, the future is no longer valid.
+   * @return The result of the task.
+   */
+  RetTy get() {
+    struct Releaser {
+      TaskFuture &Future;
+      ~Releaser() {
+        Future.reset();
+      }
+    } Release{*this};
+    return State->get();
+  }
+
+  void reset() {
+    if (State)
+      detail::FutureState<RetTy>::release(std::exchange(State, nullptr));
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_THREADS_TASK_H
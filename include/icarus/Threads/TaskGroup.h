@@ -0,0 +1,158 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_THREADS_TASKGROUP_H
+#define ICARUS_THREADS_TASKGROUP_H
+
+#include <icarus/Threads/ThreadPool.h>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace icarus {
+
+/**
+ * Group of tasks executed in a ThreadPool, which can be waited for independently of all other tasks in
+ * the pool. Waiting for the group does not block the thread: Instead, the thread executes pending tasks of
+ * the pool (of this group or any other) until all tasks of the group have finished. Therefore, tasks may
+ * create and wait for their own task groups (nested fork-join parallelism) without running out of threads.
+ *
+ * If the pool has no threads, the tasks are executed immediately in the current thread.
+ */
+class TaskGroup {
+
+  /**
+   * Marks a task of the group as finished when the task is destroyed, whether it has been executed or
+   * discarded. Declared before the callable in GroupTask, so that the callable is destroyed first.
+   */
+  struct Completion {
+    TaskGroup *Group;
+
+    explicit Completion(TaskGroup *Group) : Group(Group) {}
+    Completion(Completion &&Other) noexcept : Group(std::exchange(Other.Group, nullptr)) {}
+    Completion(const Completion &Other) = delete;
+
+    ~Completion() {
+      if (Group)
+        Group->finish();
+    }
+  };
+
+  template <typename BoundT> struct GroupTask {
+    Completion Token;
+    BoundT Bound;
+
+    void operator()() {
+      Token.Group->execute(Bound);
+    }
+  };
+
+  ThreadPool &Pool;
+  std::atomic_uint Pending = 0;
+
+  std::mutex ExceptionMutex;
+  std::exception_ptr Exception;
+
+  /**
+   * Calls the function of a task and stores the first exception thrown by a task of the group.
+   */
+  template <typename Func> void execute(Func &Function) {
+    try {
+      Function();
+    } catch (...) {
+      std::lock_guard<std::mutex> Lock(ExceptionMutex);
+      if (!Exception)
+        Exception = std::current_exception();
+    }
+  }
+
+  void finish();
+
+public:
+  /**
+   * @param Pool The pool executing the tasks of the group, by default the pool of the current thread.
+   */
+  explicit TaskGroup(ThreadPool &Pool = ThreadPool::getCurrent()) : Pool(Pool) {}
+  TaskGroup(const TaskGroup &Other) = delete;
+  TaskGroup &operator=(const TaskGroup &Other) = delete;
+
+  /**
+   * Waits for all remaining tasks. Exceptions thrown by the tasks are discarded, call TaskGroup::wait to
+   * receive them.
+   */
+  ~TaskGroup();
+
+  /**
+   * Submits a function and its arguments as a task of this group. May be called concurrently, e.g. from
+   * tasks of the group itself.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args> void run(Func &&Function, Args &&...args) {
+    auto Bound = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...);
+    if (!Pool.doGetThreadNum()) {
+      execute(Bound);
+      return;
+    }
+
+    Pending.fetch_add(1);
+    Pool.doPost(GroupTask<decltype(Bound)>{Completion(this), std::move(Bound)});
+  }
+
+  /**
+   * Submits a function and its arguments as a task of this group with the provided priority.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Priority The priority of the task (see ThreadPool::postWithPriority).
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args>
+  void runWithPriority(TaskPriority Priority, Func &&Function, Args &&...args) {
+    auto Bound = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...);
+    if (!Pool.doGetThreadNum()) {
+      execute(Bound);
+      return;
+    }
+
+    Pending.fetch_add(1);
+    Pool.doPostWithPriority(Priority, GroupTask<decltype(Bound)>{Completion(this), std::move(Bound)});
+  }
+
+  /**
+   * Submits a function and its arguments as a task of this group, which is preferably executed by a worker
+   * on the provided node (see ThreadPool::postOnNode).
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Node The node to place the task on.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args> void runOnNode(unsigned Node, Func &&Function, Args &&...args) {
+    auto Bound = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...);
+    if (!Pool.doGetThreadNum()) {
+      execute(Bound);
+      return;
+    }
+
+    Pending.fetch_add(1);
+    Pool.doPostOnNode(Node, GroupTask<decltype(Bound)>{Completion(this), std::move(Bound)});
+  }
+
+  /**
+   * Executes pending tasks of the thread pool until all tasks of this group have finished. Afterwards,
+   * the group can be reused for new tasks.
+   * @throws The first exception thrown by a task of the group, if any.
+   */
+  void wait();
+};
+
+} // namespace icarus
+
+#endif // ICARUS_THREADS_TASKGROUP_H
@@ -7,101 +7,349 @@
 
 #include <icarus/ADT/Container.h>
 
-#include <icarus/Threads/ThreadSafeQueue.h>
+#include <icarus/Threads/MPMCQueue.h>
+#include <icarus/Threads/Task.h>
+#include <icarus/Threads/Topology.h>
+#include <icarus/Threads/WorkStealingDeque.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
 
 namespace icarus {
 
+class TaskGroup;
+
+namespace passes {
+template <typename AIAContextImpl, bool Threaded, typename Iterator> class ThreadedAIAPass;
+} // namespace passes
+
 /**
- * General class representing a thread pool task. The class is used as an interface, since a derived
- * class (see ThreadTask below) always has different types depending on the template arguments. This
- * allows us to run any function with any signature in the thread pool.
+ * Priority lanes of the ThreadPool. Workers execute high priority tasks (e.g. tasks on the critical path
+ * of a schedule) before normal tasks, and background tasks only if there are no other tasks, except for
+ * a small share of takes reserved for the lower lanes.
  */
-struct Task {
-  Task() = default;
-  Task(const Task &Other) = delete;
-  Task(Task &&Other) = default;
-  virtual ~Task() = default;
-  Task &operator=(const Task &Other) = delete;
-  Task &operator=(Task &&Other) = default;
-
-  /**
-   * Executes the provided function in this thread pool task. The implementation is done by subclass
-   * as it requires a template argument that cannot be done in this interface.
-   */
-  virtual void execute() = 0;
-};
+enum class TaskPriority { High, Normal, Background };
 
 /**
- * Implementation of the Task class above. It wraps any function in a Task class
- * instance that is moved to the task queue of the thread pool.
- * @tparam Func The function signature of the task to schedule.
+ * The class for thread pool instances. Most code uses the default pool via the static methods, e.g.
+ * ThreadPool::initialize and ThreadPool::post. Additional pools can be created for work whose concurrency is
+ * sized independently of the analysis (e.g. loading modules): Their workers are started by the constructor and
+ * stopped by the destructor, and they are used via the instance methods, e.g. ThreadPool::doSubmit and
+ * ThreadPool::doParallelFor. Each thread is a worker of at most one pool.
+ *
+ * Each worker owns a WorkStealingDeque: Tasks submitted by a worker are pushed to its own deque and executed
+ * in LIFO order by the worker, while tasks submitted by other threads are pushed to the global injection queue.
+ * Workers without local tasks take tasks from the injection queue first, then steal the oldest task from the
+ * deque of another worker. Idle workers spin for a short time with exponential backoff, so that bursts of small
+ * tasks do not pay for waking up a sleeping thread, and sleep until new tasks are submitted afterwards.
+ *
+ * The threads can be pinned to CPUs with ThreadPool::pinThreads. If the pinned workers are spread over multiple
+ * NUMA nodes, each node has its own queue for tasks placed on the node (see ThreadPool::postOnNode), and workers
+ * take tasks from their own node before they take tasks from other nodes.
+ *
+ * Tasks with a high or background priority (see ThreadPool::postWithPriority) are stored in separate queues
+ * shared by all workers, which are checked before and after the normal tasks respectively.
  */
-template <typename Func> class ThreadTask : public Task {
-  Func ThreadFunction;
+class ThreadPool {
 
 public:
-  explicit ThreadTask(Func &&Function) : ThreadFunction(std::move(Function)) {}
-
-  ThreadTask(const ThreadTask &Other) = delete;
-  ThreadTask(ThreadTask &&Other) = delete;
-  ~ThreadTask() override = default;
-  ThreadTask &operator=(const ThreadTask &Other) = delete;
-  ThreadTask &operator=(ThreadTask &&Other) noexcept = default;
+  /**
+   * Number of tasks executed by the workers of a node, see ThreadPool::getNodeStatistics.
+   */
+  struct NodeStatistics {
+    unsigned Workers = 0;
+    uint64_t LocalTasks = 0;
+    uint64_t RemoteTasks = 0;
+  };
 
-  void execute() override {
-    ThreadFunction();
-  }
-};
+  /**
+   * Behavior of threads which did not find a task, see ThreadPool::setIdleOptions. While at least one thread
+   * is spinning, submitting a task does not wake up a sleeping thread. The last thread that stops spinning
+   * wakes up as many sleeping threads as there are pending tasks.
+   */
+  struct IdleOptions {
+    /* Number of failed attempts to take a task before the thread sleeps, 0 disables spinning entirely */
+    unsigned SpinRounds = 32;
+    /* Upper bound of the pause instructions between two attempts, which double after every attempt */
+    unsigned MaxBackoff = 256;
+  };
+
+private:
+  /**
+   * Specialization of the lock-free queue for scheduling thread pool tasks. All tasks stored in the
+   * queue are wrapped in TaskPtr so that they are discarded automatically if they are never executed.
+   * The queue is bounded, see ThreadPool::enqueue for tasks submitted while it is full.
+   */
+  struct TaskQueue : public MPMCQueue<TaskQueue, TaskPtr, 4096> {};
 
-/**
- * The class for a global thread pool instance. There should only be one single thread pool that can be accessed
- * via static methods to ensure uniformity and maximum throughput for all threads. Do not create a local or even
- * one or more global thread pools. Instead, use only the static methods via ThreadPool::initialize, ...
- */
-class ThreadPool {
+  /**
+   * Deque of a single worker thread. The tasks are owned by the deque until a thread removes them.
+   */
+  using TaskDeque = WorkStealingDeque<Task *>;
 
   /**
-   * Specialization of the thread safe queue for scheduling thread pool tasks. All tasks stored in the
-   * queue are wrapped in std::unique_ptr so that they are deallocated automatically after completion.
+   * Number of tasks executed by a worker, counted by the worker itself. Tasks taken from the own deque,
+   * the injection queue, the queue of the own node or a worker of the same node are local tasks.
    */
-  struct TaskQueue : public ThreadSafeQueue<TaskQueue, std::unique_ptr<Task>> {};
+  struct alignas(64) WorkerStatistics {
+    std::atomic<uint64_t> Local = 0;
+    std::atomic<uint64_t> Remote = 0;
+  };
+
+  /* Node argument of ThreadPool::schedule for tasks which are not placed on a node */
+  static constexpr unsigned AnyNode = ~0U;
+
+  /* Every N-th take checks the normal (background) lane before the higher lanes, to avoid starvation */
+  static constexpr unsigned NormalInterval = 4;
+  static constexpr unsigned BackgroundInterval = 16;
 
   std::atomic_bool Running = false;
 
+  /* Injection queue for tasks submitted by threads which are not workers of this pool */
   TaskQueue Tasks;
+  std::vector<std::unique_ptr<TaskDeque>> Deques;
+
+  /* Lanes for tasks with a priority other than TaskPriority::Normal, submitted by any thread */
+  TaskQueue HighTasks;
+  TaskQueue BackgroundTasks;
+
+  /* The thread with ID N is pinned to CPUs[N % CPUs.size()], CPUNodes contains the nodes of the CPUs */
+  std::vector<unsigned> CPUs;
+  std::vector<unsigned> CPUNodes;
+  unsigned NumNodes = 1;
+
+  /* Queues for tasks placed on a node, only used if the workers are spread over multiple nodes */
+  std::vector<std::unique_ptr<TaskQueue>> NodeTasks;
+  std::vector<unsigned> WorkerNodes;
+  std::unique_ptr<WorkerStatistics[]> Statistics;
+
+  /* Number of submitted tasks which have not been taken by a worker yet */
+  std::atomic_size_t PendingTasks = 0;
+  std::atomic_uint SpinningThreads = 0;
+  std::atomic_uint SleepingThreads = 0;
+  IdleOptions Idle;
+  std::mutex SleepMutex;
+  std::condition_variable SleepCondition;
+
   std::atomic_uint TotalTasks = 0;
   std::vector<std::thread> Threads;
 
   mutable std::shared_mutex Mutex;
   std::condition_variable_any Condition;
 
-  std::map<std::thread::id, unsigned> ThreadIDMap;
+  /* Normalized ID and node of the current thread, set by the workers themselves before they execute any task */
+  static inline thread_local unsigned ThreadID = 0;
+  static inline thread_local unsigned ThreadNode = 0;
+
+  /* Workers of the default pool have the IDs 1 to N, the workers of additional pools IDs after IDBase */
+  static constexpr unsigned PoolIDRange = 10000;
+  unsigned IDBase = 0;
+
+  struct DefaultPoolTag {};
 
   /**
-   * @return The singleton ThreadPool instance.
+   * Creates the default pool, whose workers have the thread IDs 1 to ThreadPool::getThreadNum.
    */
-  static ThreadPool &get();
+  explicit ThreadPool(DefaultPoolTag) {}
 
   /**
-   * The main logic for every ThreadPool task which waits until a new task has been enqueued before it
-   * executes the submitted function.
+   * Assigns the range of thread IDs of an additional pool, so that the IDs of its workers differ from the IDs
+   * of the workers of all other pools. Only used by the public constructors, which start the workers.
    */
-  void worker();
+  ThreadPool();
+
+  /* Number of chunks per thread for loops without an explicit grain size, to balance uneven iterations */
+  static constexpr std::size_t ChunksPerThread = 4;
+
+  /* Executes the iterations [Begin, End) of a loop in the given slot, see ThreadPool::doRunLoop */
+  using ChunkFn = void (*)(void *Context, unsigned Slot, std::size_t Begin, std::size_t End);
 
   /**
-   * Initializes the thread pool tasks and the normalized thread ID map structure.
-   * @param ThreadNum The number of threads - 1 to initialize in the tread pool.
+   * The main logic for every ThreadPool task which executes tasks from its own deque, the injection queue
+   * or the deques of other workers, and waits until a new task has been submitted if there is none.
+   * @param Index The index of the worker and its deque.
    */
-  void doInitialize(unsigned ThreadNum = std::thread::hardware_concurrency());
+  void worker(unsigned Index);
 
   /**
-   * @return The normalized thread ID of the current std::thread instance.
+   * Takes the next task for the provided worker, either from its own deque, from the injection queue or
+   * from the deque of another worker.
+   * @param Index The index of the worker, or the number of deques for threads which are not workers.
+   * @param Seed The state of the random number generator for choosing the first victim to steal from.
+   * @return The task to execute next, or nullptr if no task was found.
+   */
+  TaskPtr take(unsigned Index, uint32_t &Seed);
+
+  /**
+   * Takes the next task with normal priority for the provided worker, see ThreadPool::take.
+   * @param Index The index of the worker, or the number of deques for threads which are not workers.
+   * @param Seed The state of the random number generator for choosing the first victim to steal from.
+   * @param Remote Set to true, if the task has been taken from another node.
+   * @return The task to execute next, or nullptr if no task was found.
+   */
+  TaskPtr takeNormal(unsigned Index, uint32_t &Seed, bool &Remote);
+
+  /**
+   * Steals a task from the deque of another worker.
+   * @param Index The index of the current worker, or the number of deques for threads which are not workers.
+   * @param Seed The random number choosing the first victim.
+   * @param SameNode True, to steal from workers on the node of the current thread, false for all other workers.
+   * Without node queues, all workers are on the same node.
+   * @return The stolen task, or nullptr if no task was found.
+   */
+  TaskPtr steal(unsigned Index, uint32_t Seed, bool SameNode);
+
+  /**
+   * Schedules a task in the deque of the current worker, in the queue of a node, in the injection queue or
+   * in the lane of its priority, and wakes up a sleeping worker, if none is spinning. Normal tasks placed on
+   * the node of the current worker (or on any node) are pushed to its deque.
+   * @param T The task to schedule.
+   * @param Node The node to place the task on, or ThreadPool::AnyNode.
+   * @param Priority The priority of the task, tasks with other priorities than normal ignore the node.
+   */
+  void schedule(TaskPtr T, unsigned Node = AnyNode, TaskPriority Priority = TaskPriority::Normal);
+
+  /**
+   * Pushes a task to one of the bounded queues of the pool. Workers must never block on a full queue, since
+   * all of them could wait for each other: If the queue is full, a worker pushes the task to its own deque
+   * instead. Other threads execute pending tasks themselves until the queue has space for the task again.
+   * @param Queue The queue to push the task to.
+   * @param T The task to push.
+   */
+  void enqueue(TaskQueue &Queue, TaskPtr T);
+
+  /**
+   * Called by a thread (a worker or a thread in ThreadPool::doHelpUntilZero) which did not find a task. The
+   * thread spins for the first IdleOptions::SpinRounds calls, afterwards it sleeps until a task is submitted.
+   * @param Rounds The number of calls since the thread stopped spinning, reset when the thread sleeps.
+   * @param Counter The counter of ThreadPool::doHelpUntilZero, which also wakes up the thread, or nullptr.
+   */
+  void idle(unsigned &Rounds, const std::atomic_uint *Counter);
+
+  /**
+   * Called by a spinning thread which leaves ThreadPool::idle without sleeping (e.g. it found a task). If it
+   * was the last spinning thread, it wakes up sleeping threads for the remaining pending tasks.
+   */
+  void stopSpinning();
+
+  /**
+   * Wakes up to the provided number of sleeping threads while holding the lock only once.
+   * @param Count The number of threads to wake up.
    */
-  unsigned doGetThreadID() const;
+  void wake(std::size_t Count);
+
+  /**
+   * Executes a task taken from one of the queues and notifies threads waiting for all tasks to finish.
+   * @param T The task to execute.
+   */
+  void execute(TaskPtr T);
+
+  /**
+   * Computes the grain size, if not provided, and the number of slots of a parallel loop. Each slot is
+   * executed by a single thread at a time, so that data indexed by the slot needs no synchronization.
+   * @param Count The number of iterations of the loop.
+   * @param Grain The number of iterations per chunk, or 0 to choose it based on the number of threads.
+   * @return The number of slots executing the chunks of the loop.
+   */
+  unsigned doGetLoopSlots(std::size_t Count, std::size_t &Grain) const;
+
+  /**
+   * Splits the iterations of a loop into chunks of the grain size and executes them in the current thread
+   * (slot 0) and in one task per remaining slot. The slots take the next chunk from a shared counter until
+   * all chunks are taken, then the current thread executes pending tasks until all slots have finished.
+   * @param Count The number of iterations of the loop.
+   * @param Grain The number of iterations per chunk.
+   * @param Slots The number of slots returned by ThreadPool::doGetLoopSlots.
+   * @param Chunk The function executing a chunk of the loop.
+   * @param Context The context passed to the function.
+   * @throws The first exception thrown by the function. Remaining chunks are skipped afterwards.
+   */
+  void doRunLoop(std::size_t Count, std::size_t Grain, unsigned Slots, ChunkFn Chunk, void *Context);
+
+  /**
+   * Executes a loop over an index or iterator range in parallel. Iterators which are not random access
+   * iterators are collected first, so that the chunks can be accessed in constant time.
+   * @tparam IterT The integral type of the indices, or the type of the iterators.
+   * @tparam PrepareFn The type of the callable receiving the number of slots before the loop starts.
+   * @tparam Func The type of the callable receiving the slot and the index or the dereferenced iterator.
+   * @param Begin The first index or iterator of the range.
+   * @param End The index or iterator past the end of the range.
+   * @param Grain The number of iterations per chunk, or 0 to choose it based on the number of threads.
+   * @param Prepare The function to call with the number of slots.
+   * @param Body The function to call for each iteration.
+   */
+  template <typename IterT, typename PrepareFn, typename Func>
+  void loop(IterT Begin, IterT End, std::size_t Grain, PrepareFn &&Prepare, Func &&Body) {
+    if constexpr (std::is_integral_v<IterT>) {
+      std::size_t Count = Begin < End ? End - Begin : 0;
+      auto Chunk = [&](unsigned Slot, std::size_t First, std::size_t Last) {
+        for (std::size_t N = First; N < Last; ++N)
+          Body(Slot, static_cast<IterT>(Begin + N));
+      };
+      doLoop(Count, Grain, Prepare, Chunk);
+    } else if constexpr (std::is_base_of_v<std::random_access_iterator_tag,
+                                           typename std::iterator_traits<IterT>::iterator_category>) {
+      std::size_t Count = std::distance(Begin, End);
+      auto Chunk = [&](unsigned Slot, std::size_t First, std::size_t Last) {
+        IterT It = std::next(Begin, First);
+        for (std::size_t N = First; N < Last; ++N, ++It)
+          Body(Slot, *It);
+      };
+      doLoop(Count, Grain, Prepare, Chunk);
+    } else {
+      std::vector<IterT> Iterators;
+      for (IterT It = Begin; It != End; ++It)
+        Iterators.push_back(It);
+      loop(Iterators.begin(), Iterators.end(), Grain, Prepare, [&](unsigned Slot, IterT &It) { Body(Slot, *It); });
+    }
+  }
+
+  template <typename PrepareFn, typename Func>
+  void doLoop(std::size_t Count, std::size_t Grain, PrepareFn &Prepare, Func &Chunk) {
+    unsigned Slots = doGetLoopSlots(Count, Grain);
+    Prepare(Slots);
+    doRunLoop(
+        Count, Grain, Slots,
+        [](void *Context, unsigned Slot, std::size_t First, std::size_t Last) {
+          (*static_cast<Func *>(Context))(Slot, First, Last);
+        },
+        &Chunk);
+  }
+
+  /*
+   * The following methods are only used by the static methods of the default pool and by the classes which
+   * manage the workers of a pool themselves. Other code uses the constructor and the destructor to start
+   * and stop the workers of an additional pool.
+   */
+  friend class TaskGroup;
+  template <typename AIAContextImpl, bool Threaded, typename Iterator> friend class passes::ThreadedAIAPass;
+
+  /**
+   * Executes pending tasks in the current thread until the provided counter is zero. If there are no
+   * pending tasks, the thread spins and then sleeps until new tasks are submitted or
+   * ThreadPool::doNotifyHelpers is called after the counter reached zero.
+   * @param Counter The number of unfinished tasks the current thread waits for.
+   */
+  void doHelpUntilZero(const std::atomic_uint &Counter);
+
+  /**
+   * Wakes up all threads sleeping in ThreadPool::doHelpUntilZero, so that they can check their counters.
+   */
+  void doNotifyHelpers();
+
+  /**
+   * Initializes the deques and starts the worker threads of the thread pool. A pool which has already been
+   * initialized waits for its tasks and is shut down first, instead of starting additional workers.
+   * @param ThreadNum The number of threads - 1 to initialize in the tread pool.
+   */
+  void doInitialize(unsigned ThreadNum = std::thread::hardware_concurrency());
 
   /**
    * @return The number of threads initialized in this thread pool instance.
@@ -109,28 +357,192 @@ class ThreadPool {
   unsigned doGetThreadNum() const;
 
   /**
-   * Submits an arbitrarily typed function and its argument in the thread pool task queue.
+   * Submits an arbitrarily typed function and its argument in the thread pool task queue, without a
+   * future for its result. Use ThreadPool::awaitCompletion to wait for the function to return. As for
+   * std::thread, an exception escaping the function calls std::terminate, so callers which may throw have
+   * to catch their exceptions or use ThreadPool::doSubmit.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args> void doPost(Func &&Function, Args &&...args) {
+    ++TotalTasks;
+    schedule(TaskPtr(Task::create(std::bind(std::forward<Func>(Function), std::forward<Args>(args)...))));
+  }
+
+  /**
+   * Submits an arbitrarily typed function and its argument to the lane of the provided priority, without a
+   * future for its result.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Priority The priority of the task.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args>
+  void doPostWithPriority(TaskPriority Priority, Func &&Function, Args &&...args) {
+    ++TotalTasks;
+    schedule(TaskPtr(Task::create(std::bind(std::forward<Func>(Function), std::forward<Args>(args)...))), AnyNode,
+             Priority);
+  }
+
+  /**
+   * Submits an arbitrarily typed function and its argument to the queue of a node, without a future for its
+   * result. Workers of other nodes execute the function only if they have no tasks of their own node.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Node The node to place the task on.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args> void doPostOnNode(unsigned Node, Func &&Function, Args &&...args) {
+    ++TotalTasks;
+    schedule(TaskPtr(Task::create(std::bind(std::forward<Func>(Function), std::forward<Args>(args)...))), Node);
+  }
+
+  /**
+   * Shuts down the thread pool instance. The method needs to be called to clean up just before icarus
+   * exits, otherwise we get errors of threads not being able to join, even though the program exited.
+   * Tasks which have not been started are discarded, afterwards the pool can be initialized again.
+   */
+  void doShutdown();
+
+public:
+  /**
+   * Creates an additional thread pool and starts its workers.
+   * @param ThreadNum The number of threads - 1 to initialize in the tread pool.
+   */
+  explicit ThreadPool(unsigned ThreadNum);
+
+  /**
+   * Creates an additional thread pool and starts its workers, which are pinned to the CPUs of the provided
+   * pool (see ThreadPool::doPinThreads). Unlike ThreadPool::doPinThreads, the current thread is not pinned.
+   * @param ThreadNum The number of threads - 1 to initialize in the tread pool.
+   * @param Pinning The pool whose CPUs the workers are pinned to, e.g. the default pool.
+   */
+  ThreadPool(unsigned ThreadNum, const ThreadPool &Pinning);
+
+  ThreadPool(const ThreadPool &Other) = delete;
+  ThreadPool &operator=(const ThreadPool &Other) = delete;
+
+  /**
+   * Shuts down the workers of the pool, see ThreadPool::doShutdown.
+   */
+  ~ThreadPool();
+
+  /**
+   * @return The default ThreadPool instance, which is used by the static methods.
+   */
+  static ThreadPool &getDefault();
+
+  /**
+   * Returns the pool of the current thread, if it is a worker, or the default pool otherwise. TaskGroup and
+   * the parallel loops use this pool, so that tasks created by tasks of a pool stay in the same pool.
+   * @return The ThreadPool instance of the current thread.
+   */
+  static ThreadPool &getCurrent();
+
+  /**
+   * @return The number of threads of the pool of the current thread, see ThreadPool::getCurrent.
+   */
+  static unsigned getCurrentThreadNum();
+
+  /**
+   * @return The number of workers and the number of tasks they executed for each node.
+   */
+  std::vector<NodeStatistics> doGetNodeStatistics() const;
+
+  /**
+   * Sets the behavior of threads without tasks. Has to be called while the pool has no workers, e.g. before
+   * ThreadPool::initialize.
+   * @param Options The options for spinning.
+   */
+  void doSetIdleOptions(const IdleOptions &Options);
+
+  /**
+   * Submits an arbitrarily typed function and its argument in the thread pool task queue. The task and
+   * the shared state of the future are allocated by the TaskAllocator, so that submitting a small task
+   * does not allocate any memory once the allocator has cached enough blocks.
    * @tparam Func The type of the function to submit.
    * @tparam Args The variadic types of the function arguments.
-   * @tparam RetTy The return type of the function.
-   * @tparam PTask Type of the packaged task wrapping the callable function.
-   * @tparam TaskT The ThreadTask type with the template parameter from the function.
    * @param Function The function to execute in a thread pool task.
    * @param args The arguments to pass to the function.
-   * @return A std::future that allows us to wait for the scheduled function to return.
+   * @return A TaskFuture that allows us to wait for the scheduled function to return.
    */
   template <typename Func, typename... Args> auto doSubmit(Func &&Function, Args &&...args) {
-    auto Task = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...);
+    auto Bound = std::bind(std::forward<Func>(Function), std::forward<Args>(args)...);
 
-    using RetTy = std::result_of_t<decltype(Task)()>;
-    using PTask = std::packaged_task<RetTy()>;
-    using TaskT = ThreadTask<PTask>;
+    using RetTy = std::invoke_result_t<decltype(Bound) &>;
+    auto *State = detail::FutureState<RetTy>::create();
 
-    PTask PackagedTask(std::move(Task));
-    std::future<RetTy> Future(PackagedTask.get_future());
-    Tasks.push(std::make_unique<TaskT>(std::move(PackagedTask)));
     ++TotalTasks;
-    return Future;
+    schedule(TaskPtr(Task::create(
+        [Promise = detail::TaskPromise<RetTy>(State), Bound = std::move(Bound)]() mutable { Promise.run(Bound); })));
+    return TaskFuture<RetTy>(State);
+  }
+
+  /**
+   * Validates the CPUs by pinning the current thread to each of them, ending with the first CPU, and
+   * stores the CPUs and their nodes for the workers started by ThreadPool::doInitialize.
+   * @param NewCPUs The CPUs to pin the threads to.
+   * @param Topology The nodes of the CPUs.
+   * @return True, if all CPUs are valid.
+   */
+  bool doPinThreads(const std::vector<unsigned> &NewCPUs, const CPUTopology &Topology);
+
+  /**
+   * Calls the provided function for each index or element of a range, in parallel. The range is split into
+   * chunks which are executed by the current thread and by the threads of the pool, and the method returns
+   * after all iterations have finished. Without threads in the pool, the loop is executed sequentially.
+   * @tparam IterT The integral type of the indices, or the type of the iterators.
+   * @tparam Func The type of the callable receiving an index or a dereferenced iterator.
+   * @param Begin The first index or iterator of the range.
+   * @param End The index or iterator past the end of the range.
+   * @param Body The function to call for each iteration. Called concurrently for different iterations.
+   * @param Grain The number of iterations per chunk, or 0 to choose it based on the number of threads.
+   * @throws The first exception thrown by the function.
+   */
+  template <typename IterT, typename Func>
+  void doParallelFor(IterT Begin, IterT End, Func &&Body, std::size_t Grain = 0) {
+    loop(
+        Begin, End, Grain, [](unsigned) {}, [&](unsigned, auto &&Element) { Body(Element); });
+  }
+
+  /**
+   * Reduces the indices or elements of a range in parallel. Each slot of the loop accumulates the elements
+   * of its chunks into its own copy of the identity, so that the function does not need any locks. The
+   * accumulators are combined in the current thread after the loop has finished. Since the chunks are
+   * distributed dynamically, the combine function has to be associative and commutative.
+   * @tparam IterT The integral type of the indices, or the type of the iterators.
+   * @tparam AccT The type of the accumulators and the result.
+   * @tparam Func The type of the callable receiving an accumulator and an index or a dereferenced iterator.
+   * @tparam CombineFn The type of the callable receiving the result and an accumulator to merge into it.
+   * @param Begin The first index or iterator of the range.
+   * @param End The index or iterator past the end of the range.
+   * @param Identity The initial value of the result and of each accumulator, i.e. the neutral element.
+   * @param Body The function to accumulate an element. Called concurrently for different accumulators.
+   * @param Combine The function to merge an accumulator (passed as rvalue) into the result.
+   * @param Grain The number of iterations per chunk, or 0 to choose it based on the number of threads.
+   * @return The combined result of all accumulators.
+   * @throws The first exception thrown by the function.
+   */
+  template <typename IterT, typename AccT, typename Func, typename CombineFn>
+  AccT doParallelReduce(IterT Begin, IterT End, AccT Identity, Func &&Body, CombineFn &&Combine,
+                        std::size_t Grain = 0) {
+    /* Aligned to cache lines so that small accumulators of different slots do not share a line */
+    struct alignas(64) Accumulator {
+      AccT Value;
+    };
+
+    std::vector<Accumulator> Accumulators;
+    loop(
+        Begin, End, Grain, [&](unsigned Slots) { Accumulators.assign(Slots, Accumulator{Identity}); },
+        [&](unsigned Slot, auto &&Element) { Body(Accumulators[Slot].Value, Element); });
+
+    for (Accumulator &Acc : Accumulators)
+      Combine(Identity, std::move(Acc.Value));
+    return Identity;
   }
 
   /**
@@ -140,22 +552,63 @@ class ThreadPool {
   void doAwaitCompletion();
 
   /**
-   * Shuts down the thread pool instance. The method needs to be called to clean up just before icarus
-   * exits, otherwise we get errors of threads not being able to join, even though the program exited.
+   * Pins the current thread and all workers started afterwards to the provided CPUs: The thread with ID N
+   * runs on the CPU at index N modulo the number of CPUs. Has to be called before ThreadPool::initialize.
+   * @param CPUs The CPUs to pin the threads to.
+   * @param Topology The nodes of the CPUs, read from sysfs by default.
+   * @return True, if the current thread could be pinned to all CPUs (i.e. all CPUs are available).
    */
-  void doShutdown();
+  static bool pinThreads(const std::vector<unsigned> &CPUs, const CPUTopology &Topology = CPUTopology());
 
-public:
   /**
-   * Static method with call to singleton method ThreadPool::doInitialize.
+   * Static method with call to method ThreadPool::doInitialize of the default pool.
    * @param Threads The number of threads - 1 to initialize in the tread pool.
    */
   static void initialize(unsigned Threads);
 
   /**
+   * Returns the normalized thread ID of the current thread, which is 0 for all threads that are not workers
+   * of a pool (e.g. the main thread) and 1 to ThreadPool::getThreadNum for the workers of the default pool.
+   * Workers of additional pools have IDs in a separate range of each pool. Only reads a thread-local
+   * variable, so that it can be called on hot paths like logging.
    * @return The normalized thread ID of the current std::thread instance.
    */
-  static unsigned getThreadID();
+  static unsigned getThreadID() {
+    return ThreadID;
+  }
+
+  /**
+   * @return The NUMA node of the CPU of the current thread, or 0 if the thread is not pinned.
+   */
+  static unsigned getCurrentNode() {
+    return ThreadNode;
+  }
+
+  /**
+   * @return The number of NUMA nodes of the pinned CPUs, i.e. the greatest node number plus one.
+   */
+  static unsigned getNumNodes();
+
+  /**
+   * @return The number of workers and the number of tasks they executed for each node.
+   */
+  static std::vector<NodeStatistics> getNodeStatistics();
+
+  /**
+   * Static method with call to method ThreadPool::doSetIdleOptions of the default pool.
+   * @param Options The options for spinning.
+   */
+  static void setIdleOptions(const IdleOptions &Options);
+
+  /**
+   * @return The number of threads of the default pool which are currently spinning in ThreadPool::idle.
+   */
+  static unsigned getSpinningThreads();
+
+  /**
+   * @return The number of threads of the default pool which are currently sleeping in ThreadPool::idle.
+   */
+  static unsigned getSleepingThreads();
 
   /**
    *
@@ -164,24 +617,95 @@ public:
   static unsigned getThreadNum();
 
   /**
-   * Static method with call to singleton method ThreadPool::submit.
+   * Static method with call to method ThreadPool::doSubmit of the default pool.
    * @tparam Func The type of the function to submit.
    * @tparam Args The variadic types of the function arguments.
    * @param Function The function to execute in a thread pool task.
    * @param args The arguments to pass to the function.
-   * @return A std::future that allows us to wait for the scheduled function to return.
+   * @return A TaskFuture that allows us to wait for the scheduled function to return.
    */
   template <typename Func, typename... Args> static auto submit(Func &&Function, Args &&...args) {
-    return get().doSubmit(std::forward<Func>(Function), std::forward<Args>(args)...);
+    return getDefault().doSubmit(std::forward<Func>(Function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Static method with call to method ThreadPool::doPost of the default pool.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args> static void post(Func &&Function, Args &&...args) {
+    getDefault().doPost(std::forward<Func>(Function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Static method with call to method ThreadPool::doPostWithPriority of the default pool.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Priority The priority of the task.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args>
+  static void postWithPriority(TaskPriority Priority, Func &&Function, Args &&...args) {
+    getDefault().doPostWithPriority(Priority, std::forward<Func>(Function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Static method with call to method ThreadPool::doPostOnNode of the default pool.
+   * @tparam Func The type of the function to submit.
+   * @tparam Args The variadic types of the function arguments.
+   * @param Node The node to place the task on, e.g. the node on which the data of the task has been allocated.
+   * @param Function The function to execute in a thread pool task.
+   * @param args The arguments to pass to the function.
+   */
+  template <typename Func, typename... Args> static void postOnNode(unsigned Node, Func &&Function, Args &&...args) {
+    getDefault().doPostOnNode(Node, std::forward<Func>(Function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * Static method with call to method ThreadPool::doParallelFor of the current pool.
+   * @tparam IterT The integral type of the indices, or the type of the iterators.
+   * @tparam Func The type of the callable receiving an index or a dereferenced iterator.
+   * @param Begin The first index or iterator of the range.
+   * @param End The index or iterator past the end of the range.
+   * @param Body The function to call for each iteration. Called concurrently for different iterations.
+   * @param Grain The number of iterations per chunk, or 0 to choose it based on the number of threads.
+   */
+  template <typename IterT, typename Func>
+  static void parallelFor(IterT Begin, IterT End, Func &&Body, std::size_t Grain = 0) {
+    getCurrent().doParallelFor(Begin, End, std::forward<Func>(Body), Grain);
+  }
+
+  /**
+   * Static method with call to method ThreadPool::doParallelReduce of the current pool.
+   * @tparam IterT The integral type of the indices, or the type of the iterators.
+   * @tparam AccT The type of the accumulators and the result.
+   * @tparam Func The type of the callable receiving an accumulator and an index or a dereferenced iterator.
+   * @tparam CombineFn The type of the callable receiving the result and an accumulator to merge into it.
+   * @param Begin The first index or iterator of the range.
+   * @param End The index or iterator past the end of the range.
+   * @param Identity The initial value of the result and of each accumulator, i.e. the neutral element.
+   * @param Body The function to accumulate an element. Called concurrently for different accumulators.
+   * @param Combine The function to merge an accumulator (passed as rvalue) into the result.
+   * @param Grain The number of iterations per chunk, or 0 to choose it based on the number of threads.
+   * @return The combined result of all accumulators.
+   */
+  template <typename IterT, typename AccT, typename Func, typename CombineFn>
+  static AccT parallelReduce(IterT Begin, IterT End, AccT Identity, Func &&Body, CombineFn &&Combine,
+                             std::size_t Grain = 0) {
+    return getCurrent().doParallelReduce(Begin, End, std::move(Identity), std::forward<Func>(Body),
+                                         std::forward<CombineFn>(Combine), Grain);
   }
 
   /**
-   * Static method with call to singleton method ThreadPool::doAwaitCompletion.
+   * Static method with call to method ThreadPool::doAwaitCompletion of the default pool.
    */
   static void awaitCompletion();
 
   /**
-   * Static method with call to singleton method ThreadLogger::doShutdown.
+   * Static method with call to method ThreadPool::doShutdown of the default pool.
    */
   static void shutdown();
 };
@@ -56,6 +56,21 @@ struct ThreadSafeQueue : public ThreadSafeContainer<ThreadSafeQueue<SubClass, T>
     this->Container.pop();
     return true;
   }
+
+  /**
+   * Removes the first element from the queue and returns it while holding an unique (read-write) lock
+   * if the queue is not empty. Unlike pop, the method does not block if the queue is empty.
+   * @param t The reference to the variable where the first element of the queue is assigned to.
+   * @return True, if the element was successfully removed and assigned to the reference.
+   */
+  bool tryPop(T &t) {
+    std::unique_lock<std::shared_mutex> Lock(this->Mutex);
+    if (this->Container.empty())
+      return false;
+    t = std::move(this->Container.front());
+    this->Container.pop();
+    return true;
+  }
 };
 
 } // namespace icarus
@@ -0,0 +1,62 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_THREADS_TOPOLOGY_H
+#define ICARUS_THREADS_TOPOLOGY_H
+
+#include <llvm/ADT/StringRef.h>
+
+#include <optional>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Parses a list of CPUs in the format of the cpulist files of Linux, i.e. comma-separated CPU numbers and
+ * inclusive ranges of CPU numbers (e.g. "0-3,8,10-11"). The CPUs are returned in the order of the list.
+ * @param List The list of CPUs to parse.
+ * @return The CPUs of the list, or std::nullopt if the list is malformed.
+ */
+std::optional<std::vector<unsigned>> parseCPUList(llvm::StringRef List);
+
+/**
+ * Assignment of CPUs to NUMA nodes, read from the node directories of sysfs. On systems without NUMA
+ * information (or other operating systems), all CPUs belong to node 0.
+ */
+class CPUTopology {
+
+  std::vector<unsigned> CPUNodes;
+  unsigned NumNodes = 1;
+
+public:
+  /**
+   * Reads the nodes and their CPUs from the cpulist files in the provided directory.
+   * @param NodePath The directory containing the nodeN subdirectories.
+   */
+  explicit CPUTopology(llvm::StringRef NodePath = "/sys/devices/system/node");
+
+  /**
+   * @param CPU The number of a CPU.
+   * @return The node of the CPU, or 0 if the node is unknown.
+   */
+  unsigned getNode(unsigned CPU) const;
+
+  /**
+   * @return The number of nodes, i.e. the greatest node number plus one.
+   */
+  unsigned getNumNodes() const {
+    return NumNodes;
+  }
+};
+
+/**
+ * Restricts the current thread to run on the provided CPU only.
+ * @param CPU The number of the CPU.
+ * @return True, if the affinity of the thread has been changed.
+ */
+bool pinCurrentThread(unsigned CPU);
+
+} // namespace icarus
+
+#endif // ICARUS_THREADS_TOPOLOGY_H
@@ -0,0 +1,172 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef ICARUS_THREADS_WORKSTEALINGDEQUE_H
+#define ICARUS_THREADS_WORKSTEALINGDEQUE_H
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace icarus {
+
+/**
+ * Lock-free double-ended queue of Chase and Lev, in the formulation for the C11 memory model by Lê et al.
+ * ("Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013). A single owner thread pushes
+ * and pops elements at the bottom of the deque, any number of other threads steal elements from the top.
+ * The owner only synchronizes with thieves when the deque contains at most one element.
+ *
+ * The circular array grows when it is full. Thieves may still read from the previous array, so that all
+ * arrays are kept until the deque is destroyed (at most twice the memory of the largest array).
+ * @tparam ElementT The type of the elements, usually a pointer. Elements are copied with atomic loads and stores.
+ */
+template <typename ElementT> class WorkStealingDeque {
+
+  static_assert(std::is_trivially_copyable_v<ElementT>, "Elements of WorkStealingDeque must be trivially copyable");
+
+  class Array {
+    std::size_t Capacity;
+    std::unique_ptr<std::atomic<ElementT>[]> Elements;
+
+  public:
+    explicit Array(std::size_t Capacity) : Capacity(Capacity), Elements(new std::atomic<ElementT>[Capacity]) {}
+
+    std::size_t capacity() const {
+      return Capacity;
+    }
+
+    ElementT get(int64_t Index) const {
+      return Elements[Index & (Capacity - 1)].load(std::memory_order_relaxed);
+    }
+
+    void put(int64_t Index, ElementT Value) {
+      Elements[Index & (Capacity - 1)].store(Value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @param Top The index of the first element.
+     * @param Bottom The index after the last element.
+     * @return A new array of twice the capacity with the same elements at the same indices.
+     */
+    Array *grow(int64_t Top, int64_t Bottom) const {
+      auto *Grown = new Array(Capacity * 2);
+      for (int64_t Index = Top; Index < Bottom; ++Index)
+        Grown->put(Index, get(Index));
+      return Grown;
+    }
+  };
+
+  alignas(64) std::atomic<int64_t> Top = 0;
+  alignas(64) std::atomic<int64_t> Bottom = 0;
+  alignas(64) std::atomic<Array *> Buffer;
+
+  /* All arrays allocated by the owner, the last one is the current buffer */
+  std::vector<std::unique_ptr<Array>> Arrays;
+
+public:
+  /**
+   * @param Capacity The initial capacity of the deque, must be a power of two.
+   */
+  explicit WorkStealingDeque(std::size_t Capacity = 256) {
+    assert(Capacity && !(Capacity & (Capacity - 1)) && "Capacity must be a power of two");
+    Arrays.emplace_back(new Array(Capacity));
+    Buffer.store(Arrays.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque &Other) = delete;
+  WorkStealingDeque &operator=(const WorkStealingDeque &Other) = delete;
+
+  /**
+   * Add an element at the bottom of the deque. Must only be called by the owner.
+   * @param Value The element to add.
+   */
+  void push(ElementT Value) {
+    int64_t B = Bottom.load(std::memory_order_relaxed);
+    int64_t T = Top.load(std::memory_order_acquire);
+    Array *A = Buffer.load(std::memory_order_relaxed);
+    if (B - T > static_cast<int64_t>(A->capacity()) - 1) {
+      A = A->grow(T, B);
+      Arrays.emplace_back(A);
+      Buffer.store(A, std::memory_order_release);
+    }
+    A->put(B, Value);
+    Bottom.store(B + 1, std::memory_order_release);
+  }
+
+  /**
+   * Remove the element at the bottom of the deque, i.e. the element pushed last. Must only be called by
+   * the owner.
+   * @param Value The removed element.
+   * @return False, if the deque was empty or the last element was stolen concurrently.
+   */
+  bool pop(ElementT &Value) {
+    int64_t B = Bottom.load(std::memory_order_relaxed) - 1;
+    Array *A = Buffer.load(std::memory_order_relaxed);
+    Bottom.store(B, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t T = Top.load(std::memory_order_relaxed);
+
+    if (T > B) {
+      Bottom.store(B + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    Value = A->get(B);
+    if (T < B)
+      return true;
+
+    /* Last element: Race against thieves by incrementing the top index instead */
+    bool Won = Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    Bottom.store(B + 1, std::memory_order_relaxed);
+    return Won;
+  }
+
+  /**
+   * Remove the element at the top of the deque, i.e. the oldest element. May be called by any thread.
+   * @param Value The removed element.
+   * @return False, if the deque was empty or another thread removed the element concurrently.
+   */
+  bool steal(ElementT &Value) {
+    int64_t T = Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t B = Bottom.load(std::memory_order_acquire);
+    if (T >= B)
+      return false;
+
+    Array *A = Buffer.load(std::memory_order_acquire);
+    auto Stolen = A->get(T);
+    if (!Top.compare_exchange_strong(T, T + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      return false;
+
+    Value = Stolen;
+    return true;
+  }
+
+  /**
+   * @return The number of elements in the deque. Only exact if no other thread modifies the deque.
+   */
+  std::size_t size() const {
+    int64_t B = Bottom.load(std::memory_order_relaxed);
+    int64_t T = Top.load(std::memory_order_relaxed);
+    return B > T ? B - T : 0;
+  }
+
+  bool empty() const {
+    return !size();
+  }
+
+  /**
+   * @return The capacity of the current array.
+   */
+  std::size_t capacity() const {
+    return Buffer.load(std::memory_order_relaxed)->capacity();
+  }
+};
+
+} // namespace icarus
+
+#endif // ICARUS_THREADS_WORKSTEALINGDEQUE_H
@@ -0,0 +1,187 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <llvm/IR/Instructions.h>
+
+#include <icarus/Analysis/CallGraph.h>
+
+#include <icarus/Support/Clang.h>
+
+#include <algorithm>
+
+namespace icarus {
+
+/**
+ * @param Call A call or invoke instruction.
+ * @return The function directly called by the instruction, or nullptr for indirect calls.
+ */
+template <typename CallT> static llvm::Function *getCalledFunction(CallT *Call) {
+#if ICARUS_CLANG_VERSION >= 11
+  llvm::Value *Callee = Call->getCalledOperand();
+#else
+  llvm::Value *Callee = Call->getCalledValue();
+#endif
+  return llvm::dyn_cast<llvm::Function>(Callee->stripPointerCasts());
+}
+
+/**
+ * @param I An instruction of a function.
+ * @return The function directly called by the instruction, or nullptr if it is no direct call.
+ */
+static llvm::Function *getCalledFunction(llvm::Instruction &I) {
+  if (auto *Call = llvm::dyn_cast<llvm::CallInst>(&I))
+    return getCalledFunction(Call);
+  if (auto *Invoke = llvm::dyn_cast<llvm::InvokeInst>(&I))
+    return getCalledFunction(Invoke);
+  return nullptr;
+}
+
+/*
+ * CallGraphSCCs methods
+ */
+
+CallGraphSCCs::CallGraphSCCs(llvm::ArrayRef<llvm::Module *> Modules) {
+  std::vector<llvm::Function *> Functions;
+  llvm::DenseMap<const llvm::Function *, unsigned> Indices;
+  for (llvm::Module *M : Modules) {
+    for (llvm::Function &F : *M) {
+      if (F.isDeclaration())
+        continue;
+      Indices[&F] = Functions.size();
+      Functions.push_back(&F);
+      if (!F.hasLocalLinkage())
+        Definitions.try_emplace(F.getName(), &F);
+    }
+  }
+
+  std::vector<std::vector<unsigned>> Successors(Functions.size());
+  for (unsigned N = 0; N < Functions.size(); ++N) {
+    for (llvm::BasicBlock &BB : *Functions[N]) {
+      for (llvm::Instruction &I : BB) {
+        llvm::Function *Callee = resolve(getCalledFunction(I));
+        if (Callee)
+          Successors[N].push_back(Indices.lookup(Callee));
+      }
+    }
+    std::sort(Successors[N].begin(), Successors[N].end());
+    Successors[N].erase(std::unique(Successors[N].begin(), Successors[N].end()), Successors[N].end());
+  }
+
+  computeSCCs(Functions, Successors);
+  computeCriticalPath();
+}
+
+/**
+ * Tarjan's algorithm without recursion, as call chains in large programs can exceed the stack size. The
+ * algorithm completes each SCC only after all SCCs reachable from it, which yields the bottom-up order.
+ */
+void CallGraphSCCs::computeSCCs(const std::vector<llvm::Function *> &Functions,
+                                const std::vector<std::vector<unsigned>> &Successors) {
+  static constexpr unsigned Unvisited = ~0U;
+
+  std::vector<unsigned> Order(Functions.size(), Unvisited);
+  std::vector<unsigned> LowLink(Functions.size());
+  std::vector<bool> OnStack(Functions.size());
+  std::vector<unsigned> Stack;
+  std::vector<unsigned> Components(Functions.size());
+
+  /* Call stack of the depth-first search: the function and the index of its next successor */
+  std::vector<std::pair<unsigned, unsigned>> Path;
+  unsigned NextOrder = 0;
+
+  for (unsigned Root = 0; Root < Functions.size(); ++Root) {
+    if (Order[Root] != Unvisited)
+      continue;
+
+    Path.emplace_back(Root, 0);
+    while (!Path.empty()) {
+      auto &[N, NextSucc] = Path.back();
+      if (NextSucc == 0 && Order[N] == Unvisited) {
+        Order[N] = LowLink[N] = NextOrder++;
+        Stack.push_back(N);
+        OnStack[N] = true;
+      }
+
+      if (NextSucc < Successors[N].size()) {
+        unsigned Succ = Successors[N][NextSucc++];
+        if (Order[Succ] == Unvisited)
+          Path.emplace_back(Succ, 0);
+        else if (OnStack[Succ])
+          LowLink[N] = std::min(LowLink[N], Order[Succ]);
+        continue;
+      }
+
+      unsigned Finished = N;
+      Path.pop_back();
+      if (!Path.empty())
+        LowLink[Path.back().first] = std::min(LowLink[Path.back().first], LowLink[Finished]);
+      if (LowLink[Finished] != Order[Finished])
+        continue;
+
+      SCC &C = SCCs.emplace_back();
+      C.Index = SCCs.size() - 1;
+      unsigned Member;
+      do {
+        Member = Stack.back();
+        Stack.pop_back();
+        OnStack[Member] = false;
+        Components[Member] = C.Index;
+        C.Functions.push_back(Functions[Member]);
+        FunctionSCCs[Functions[Member]] = C.Index;
+      } while (Member != Finished);
+    }
+  }
+
+  for (unsigned N = 0; N < Functions.size(); ++N) {
+    SCC &C = SCCs[Components[N]];
+    for (unsigned Succ : Successors[N]) {
+      if (Components[Succ] == C.Index)
+        C.Recursive = true;
+      else
+        C.Callees.push_back(Components[Succ]);
+    }
+  }
+
+  for (SCC &C : SCCs) {
+    std::sort(C.Callees.begin(), C.Callees.end());
+    C.Callees.erase(std::unique(C.Callees.begin(), C.Callees.end()), C.Callees.end());
+    for (unsigned Callee : C.Callees)
+      SCCs[Callee].Callers.push_back(C.Index);
+  }
+}
+
+/**
+ * The length of the longest chain of calls through an SCC is the sum of the longest chains to a leaf
+ * (Depth, computed bottom-up) and to a root (Height, computed top-down), counting the SCC only once.
+ */
+void CallGraphSCCs::computeCriticalPath() {
+  std::vector<unsigned> Depth(SCCs.size(), 1);
+  std::vector<unsigned> Height(SCCs.size(), 1);
+
+  for (SCC &C : SCCs)
+    for (unsigned Callee : C.Callees)
+      Depth[C.Index] = std::max(Depth[C.Index], Depth[Callee] + 1);
+  for (auto It = SCCs.rbegin(); It != SCCs.rend(); ++It)
+    for (unsigned Caller : It->Callers)
+      Height[It->Index] = std::max(Height[It->Index], Height[Caller] + 1);
+
+  unsigned Longest = 0;
+  for (SCC &C : SCCs)
+    Longest = std::max(Longest, Depth[C.Index] + Height[C.Index] - 1);
+  for (SCC &C : SCCs)
+    C.Critical = Depth[C.Index] + Height[C.Index] - 1 == Longest;
+}
+
+llvm::Function *CallGraphSCCs::resolve(llvm::Function *F) const {
+  if (!F || !F->isDeclaration())
+    return F;
+  return Definitions.lookup(F->getName());
+}
+
+const CallGraphSCCs::SCC *CallGraphSCCs::getSCC(llvm::Function *F) const {
+  auto It = FunctionSCCs.find(resolve(F));
+  return It != FunctionSCCs.end() ? &SCCs[It->second] : nullptr;
+}
+
+} // namespace icarus
@@ -0,0 +1,106 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <icarus/Analysis/Checkpoint.h>
+
+#include <fstream>
+#include <iterator>
+
+#include <unistd.h>
+
+namespace icarus {
+
+static constexpr llvm::StringLiteral CheckpointMagic = "ICARUSCP";
+static constexpr uint64_t CheckpointVersion = 1;
+
+/*
+ * Checkpointer methods
+ */
+
+Checkpointer::Checkpointer(const ModuleIndex &Index, llvm::StringRef Path, std::chrono::seconds Interval)
+    : Index(Index), Path(Path.str()), Interval(Interval),
+      LastCheckpoint(std::chrono::steady_clock::now().time_since_epoch().count()) {}
+
+bool Checkpointer::isEnabled() const {
+  return !Path.empty();
+}
+
+bool Checkpointer::isDue() const {
+  std::chrono::steady_clock::duration Last(LastCheckpoint.load(std::memory_order_relaxed));
+  return isEnabled() && std::chrono::steady_clock::now().time_since_epoch() - Last >= Interval;
+}
+
+bool Checkpointer::write(llvm::ArrayRef<std::string> States) {
+  if (!isEnabled())
+    return false;
+
+  ContextWriter Header(Index);
+  Header.writeVarint(CheckpointVersion);
+  Header.writeVarint(Index.getFingerprint());
+  Header.writeVarint(States.size());
+
+  std::string TempPath = Path + ".tmp";
+  int FD;
+  if (llvm::sys::fs::openFileForWrite(TempPath, FD))
+    return false;
+
+  {
+    llvm::raw_fd_ostream File(FD, /*shouldClose=*/false);
+    File << CheckpointMagic << Header.getBuffer();
+    for (const std::string &State : States) {
+      ContextWriter Size(Index);
+      Size.writeVarint(State.size());
+      File << Size.getBuffer() << State;
+    }
+    File.flush();
+    if (File.has_error()) {
+      File.clear_error();
+      ::close(FD);
+      return false;
+    }
+  }
+
+  /* The data has to reach the disk before the rename, otherwise a crash may leave an empty checkpoint behind */
+  bool Synced = !::fsync(FD);
+  if (::close(FD) || !Synced)
+    return false;
+
+  if (llvm::sys::fs::rename(TempPath, Path))
+    return false;
+
+  LastCheckpoint.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+  return true;
+}
+
+bool Checkpointer::read(std::vector<std::string> &States) const {
+  std::ifstream File(Path, std::ios::binary);
+  if (!isEnabled() || !File)
+    return false;
+
+  std::string Data((std::istreambuf_iterator<char>(File)), std::istreambuf_iterator<char>());
+  if (!llvm::StringRef(Data).startswith(CheckpointMagic))
+    return false;
+
+  ContextReader Reader(Index, llvm::StringRef(Data).drop_front(CheckpointMagic.size()));
+  uint64_t Version, Fingerprint, Count;
+  if (!Reader.readVarint(Version) || Version != CheckpointVersion)
+    return false;
+  if (!Reader.readVarint(Fingerprint) || Fingerprint != Index.getFingerprint())
+    return false;
+  if (!Reader.readVarint(Count))
+    return false;
+
+  for (uint64_t N = 0; N < Count; ++N) {
+    std::string State;
+    if (!Reader.readString(State))
+      return false;
+    States.push_back(std::move(State));
+  }
+  return Reader.atEnd();
+}
+
+} // namespace icarus
@@ -0,0 +1,306 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <llvm/IR/Constant.h>
+#include <llvm/IR/Instruction.h>
+
+#include <icarus/Analysis/ContextSerializer.h>
+#include <icarus/Analysis/FunctionSlots.h>
+
+namespace icarus {
+
+/*
+ * ModuleIndex methods
+ */
+
+ModuleIndex::ModuleIndex(llvm::ArrayRef<llvm::Module *> Modules) : Modules(Modules.begin(), Modules.end()) {
+  Globals.resize(this->Modules.size());
+  Functions.resize(this->Modules.size());
+
+  for (unsigned M = 0; M < this->Modules.size(); ++M) {
+    for (llvm::GlobalVariable &GV : this->Modules[M]->globals()) {
+      Positions[&GV] = {M, Globals[M].size()};
+      Globals[M].push_back(&GV);
+    }
+    for (llvm::Function &F : *this->Modules[M]) {
+      Positions[&F] = {M, Functions[M].size()};
+      Functions[M].push_back(&F);
+
+      std::vector<llvm::BasicBlock *> &FunctionBlocks = Blocks[&F];
+      for (llvm::BasicBlock &BB : F) {
+        Positions[&BB] = {M, FunctionBlocks.size()};
+        FunctionBlocks.push_back(&BB);
+      }
+    }
+  }
+}
+
+uint64_t ModuleIndex::getFingerprint() const {
+  /* FNV-1a instead of llvm::hash_code, as the fingerprint must not change between different runs */
+  uint64_t Hash = 0xcbf29ce484222325ULL;
+  auto Combine = [&](llvm::StringRef Bytes) {
+    for (char C : Bytes) {
+      Hash ^= static_cast<uint8_t>(C);
+      Hash *= 0x100000001b3ULL;
+    }
+    Hash ^= 0xFF;
+    Hash *= 0x100000001b3ULL;
+  };
+  auto CombineInt = [&](uint64_t Value) { Combine(llvm::StringRef(reinterpret_cast<char *>(&Value), sizeof(Value))); };
+
+  CombineInt(Modules.size());
+  for (unsigned M = 0; M < Modules.size(); ++M) {
+    Combine(Modules[M]->getModuleIdentifier());
+    CombineInt(Globals[M].size());
+    CombineInt(Functions[M].size());
+    for (llvm::Function *F : Functions[M]) {
+      Combine(F->getName());
+      CombineInt(F->isDeclaration() ? 0 : FunctionSlots::get(*F).getNumSlots());
+    }
+  }
+  return Hash;
+}
+
+bool ModuleIndex::encode(const llvm::Value *V, std::vector<uint64_t> &Indices) const {
+  if (!V) {
+    Indices.push_back(VK_Null);
+    return true;
+  }
+
+  auto Encode = [&](unsigned Kind, std::initializer_list<uint64_t> Values) {
+    Indices.push_back(Kind);
+    Indices.insert(Indices.end(), Values);
+    return true;
+  };
+
+  /* Position of the function of local values and basic blocks */
+  auto FunctionPosition = [&](const llvm::Function *F) { return Positions.lookup(F); };
+
+  if (llvm::isa<llvm::GlobalVariable>(V) || llvm::isa<llvm::Function>(V)) {
+    auto I = Positions.find(V);
+    if (I != Positions.end())
+      return Encode(llvm::isa<llvm::Function>(V) ? VK_Function : VK_Global, {I->second.first, I->second.second});
+  } else if (auto *BB = llvm::dyn_cast<llvm::BasicBlock>(V)) {
+    auto I = Positions.find(BB);
+    if (I != Positions.end()) {
+      auto [M, F] = FunctionPosition(BB->getParent());
+      return Encode(VK_Block, {M, F, I->second.second});
+    }
+  } else if (llvm::isa<llvm::Argument>(V) || llvm::isa<llvm::Instruction>(V)) {
+    const llvm::Function *F = llvm::isa<llvm::Argument>(V) ? llvm::cast<llvm::Argument>(V)->getParent()
+                                                           : llvm::cast<llvm::Instruction>(V)->getFunction();
+    if (F && Positions.count(F)) {
+      auto [M, N] = FunctionPosition(F);
+      int Slot = FunctionSlots::get(*const_cast<llvm::Function *>(F)).getSlot(V);
+      return Encode(VK_Local, {M, N, static_cast<uint64_t>(Slot)});
+    }
+  } else if (llvm::isa<llvm::Constant>(V)) {
+    for (const llvm::Use &U : V->uses()) {
+      auto *I = llvm::dyn_cast<llvm::Instruction>(U.getUser());
+      if (!I || !I->getFunction() || !Positions.count(I->getFunction()))
+        continue;
+      auto [M, N] = FunctionPosition(I->getFunction());
+      int Slot = FunctionSlots::get(*const_cast<llvm::Function *>(I->getFunction())).getSlot(I);
+      return Encode(VK_Constant, {M, N, static_cast<uint64_t>(Slot), U.getOperandNo()});
+    }
+  }
+
+  Indices.push_back(VK_Null);
+  return false;
+}
+
+unsigned ModuleIndex::getNumIndices(unsigned Kind) {
+  switch (Kind) {
+  case VK_Global:
+  case VK_Function:
+    return 2;
+  case VK_Local:
+  case VK_Block:
+    return 3;
+  case VK_Constant:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+bool ModuleIndex::decode(llvm::ArrayRef<uint64_t> &Indices, llvm::Value *&V) const {
+  V = nullptr;
+  if (Indices.empty())
+    return false;
+
+  unsigned Kind = Indices.front();
+  if (Kind > VK_Constant || Indices.size() < 1 + getNumIndices(Kind))
+    return false;
+  llvm::ArrayRef<uint64_t> Args = Indices.slice(1, getNumIndices(Kind));
+  Indices = Indices.drop_front(1 + getNumIndices(Kind));
+
+  if (Kind == VK_Null)
+    return true;
+
+  uint64_t M = Args[0];
+  if (M >= Modules.size())
+    return false;
+
+  if (Kind == VK_Global) {
+    if (Args[1] < Globals[M].size())
+      V = Globals[M][Args[1]];
+    return V != nullptr;
+  }
+
+  if (Args[1] >= Functions[M].size())
+    return false;
+  llvm::Function *F = Functions[M][Args[1]];
+
+  if (Kind == VK_Function) {
+    V = F;
+    return true;
+  }
+
+  if (Kind == VK_Block) {
+    const std::vector<llvm::BasicBlock *> &FunctionBlocks = Blocks.find(F)->second;
+    if (Args[2] < FunctionBlocks.size())
+      V = FunctionBlocks[Args[2]];
+    return V != nullptr;
+  }
+
+  const FunctionSlots &Slots = FunctionSlots::get(*F);
+  if (Args[2] >= Slots.getNumSlots())
+    return false;
+  llvm::Value *Local = Slots.getValue(Args[2]);
+
+  if (Kind == VK_Local) {
+    V = Local;
+    return true;
+  }
+
+  auto *I = llvm::dyn_cast<llvm::Instruction>(Local);
+  if (!I || Args[3] >= I->getNumOperands() || !llvm::isa<llvm::Constant>(I->getOperand(Args[3])))
+    return false;
+  V = I->getOperand(Args[3]);
+  return true;
+}
+
+/*
+ * ContextWriter methods
+ */
+
+const std::string &ContextWriter::getBuffer() const {
+  return Buffer;
+}
+
+std::string ContextWriter::takeBuffer() {
+  return std::move(Buffer);
+}
+
+bool ContextWriter::hasFailed() const {
+  return Failed;
+}
+
+void ContextWriter::writeVarint(uint64_t Value) {
+  do {
+    uint8_t Byte = Value & 0x7F;
+    Value >>= 7;
+    Buffer.push_back(static_cast<char>(Value ? Byte | 0x80 : Byte));
+  } while (Value);
+}
+
+void ContextWriter::writeString(llvm::StringRef String) {
+  writeVarint(String.size());
+  Buffer.append(String.begin(), String.end());
+}
+
+void ContextWriter::writeValue(const llvm::Value *V) {
+  std::vector<uint64_t> Indices;
+  Index.encode(V, Indices);
+  for (uint64_t I : Indices)
+    writeVarint(I);
+}
+
+void ContextWriter::writeDelegate(const ValueDelegate &Delegate) {
+  std::vector<uint64_t> Indices;
+  if (!Delegate.isValid()) {
+    writeVarint(0);
+  } else if (!Delegate.isNodeDelegate()) {
+    /* Values that cannot be encoded are written as unknown values */
+    if (!Index.encode(Delegate.getValue(), Indices)) {
+      writeVarint(0);
+      return;
+    }
+    writeVarint(1);
+    writeValue(Delegate.getValue());
+  } else {
+    /* The reader rejects delegates to regions which do not exist, so the state could not be restored */
+    llvm::Value *Base = Delegate.getBase();
+    if (!Regions.count(Base)) {
+      Failed = true;
+      writeVarint(0);
+      return;
+    }
+    writeVarint(2);
+    writeValue(Base);
+    writeVarint(Delegate.getOffset());
+  }
+}
+
+/*
+ * ContextReader methods
+ */
+
+bool ContextReader::fail() {
+  Failed = true;
+  return false;
+}
+
+bool ContextReader::hasFailed() const {
+  return Failed;
+}
+
+bool ContextReader::atEnd() const {
+  return Pos == Data.size();
+}
+
+bool ContextReader::readVarint(uint64_t &Value) {
+  Value = 0;
+  if (Failed)
+    return false;
+  for (unsigned Shift = 0; Shift < 64; Shift += 7) {
+    if (Pos == Data.size())
+      return fail();
+    uint8_t Byte = static_cast<uint8_t>(Data[Pos++]);
+    Value |= static_cast<uint64_t>(Byte & 0x7F) << Shift;
+    if (!(Byte & 0x80))
+      return true;
+  }
+  return fail();
+}
+
+bool ContextReader::readString(std::string &String) {
+  uint64_t Size;
+  if (!readVarint(Size))
+    return false;
+  if (Size > Data.size() - Pos)
+    return fail();
+  String = Data.substr(Pos, Size).str();
+  Pos += Size;
+  return true;
+}
+
+bool ContextReader::readValue(llvm::Value *&V) {
+  uint64_t Indices[5];
+  if (!readVarint(Indices[0]))
+    return false;
+  if (Indices[0] > ModuleIndex::VK_Constant)
+    return fail();
+
+  unsigned NumIndices = ModuleIndex::getNumIndices(Indices[0]);
+  for (unsigned I = 1; I <= NumIndices; ++I)
+    if (!readVarint(Indices[I]))
+      return false;
+
+  llvm::ArrayRef<uint64_t> Encoded(Indices, 1 + NumIndices);
+  return Index.decode(Encoded, V) || fail();
+}
+
+} // namespace icarus
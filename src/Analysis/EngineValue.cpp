@@ -2,46 +2,201 @@
 // Created by croemheld on 27.02.2023.
 //
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/Allocator.h>
+
 #include <icarus/Analysis/EngineValue.h>
 
+#include <algorithm>
+#include <mutex>
+#include <tuple>
+
 namespace icarus {
 
 /*
  * ValueDelegate methods
  */
 
-bool ValueDelegate::isValid() const {
-  return isNode ? Node != nullptr : CVal && !Offset;
+const ValueDelegate::OffsetRecord *ValueDelegate::getOffsetRecord(llvm::Value *Base, uint64_t Offset) {
+  static std::mutex Mutex;
+  static llvm::BumpPtrAllocator Allocator;
+  static llvm::DenseMap<std::pair<llvm::Value *, uint64_t>, OffsetRecord *> Records;
+
+  std::lock_guard<std::mutex> Lock(Mutex);
+  OffsetRecord *&Record = Records[{Base, Offset}];
+  if (!Record)
+    Record = new (Allocator.Allocate<OffsetRecord>()) OffsetRecord{Base, Offset};
+  return Record;
+}
+
+ValueDelegate::ValueDelegate(const EngineValue *Node, uint64_t Offset) : Bits(0) {
+  if (!Node)
+    return;
+
+  llvm::Value *Base = Node->getBase();
+  assert((Base) && "Delegates can only point to nodes with a base");
+  auto Ptr = reinterpret_cast<uintptr_t>(Base);
+  if ((Ptr & ~PointerMask) == 0 && Offset < (uint64_t(1) << OffsetBits))
+    Bits = Ptr | TagNode | (OffsetBits ? static_cast<uintptr_t>(Offset) << PointerBits : 0);
+  else
+    Bits = reinterpret_cast<uintptr_t>(getOffsetRecord(Base, Offset)) | TagRecord;
 }
 
-bool ValueDelegate::isNodeDelegate() const {
-  return isValid() && isNode;
+const void *ValueDelegate::getIdentity() const {
+  return isNodeDelegate() ? getBase() : getValue();
 }
 
-EngineValue *ValueDelegate::getNode() const {
-  assert((isNode));
-  return Node;
+bool ValueDelegate::operator==(const ValueDelegate &Other) const {
+  return isNodeDelegate() == Other.isNodeDelegate() && getIdentity() == Other.getIdentity() &&
+         (!isNodeDelegate() || getOffset() == Other.getOffset());
 }
 
-uint64_t ValueDelegate::getOffset() const {
-  return Offset;
+bool ValueDelegate::operator!=(const ValueDelegate &Other) const {
+  return !(*this == Other);
 }
 
-ValueDelegate ValueDelegate::getDelegate() const {
-  return Node->getDelegate(*this);
+bool ValueDelegate::operator<(const ValueDelegate &Other) const {
+  auto Key = [](const ValueDelegate &D) {
+    return std::make_tuple(D.isNodeDelegate(), D.getIdentity(), D.isNodeDelegate() ? D.getOffset() : 0);
+  };
+  return Key(*this) < Key(Other);
+}
+
+llvm::hash_code hash_value(const ValueDelegate &Delegate) {
+  return llvm::hash_combine(Delegate.isNodeDelegate(), Delegate.getIdentity(),
+                            Delegate.isNodeDelegate() ? Delegate.getOffset() : 0);
 }
 
 /*
  * EngineValue methods
  */
 
-ValueDelegate EngineValue::getDelegate(const ValueDelegate &Delegate) {
-  assert((Delegate.isNodeDelegate() && Delegate.getNode() == this));
-  return Values[Delegate.getOffset()];
+llvm::Value *EngineValue::getBase() const {
+  return Base;
+}
+
+uint64_t EngineValue::getSize() const {
+  return Size;
+}
+
+std::size_t EngineValue::getNumFragments() const {
+  return Values.size();
+}
+
+ValueDelegate EngineValue::getDelegate(const ValueDelegate &Delegate) const {
+  assert((Delegate.isNodeDelegate() && Delegate.getBase() == Base));
+  return getDelegate(Delegate.getOffset());
+}
+
+ValueDelegate EngineValue::getDelegate(uint64_t Offset) const {
+  auto I = Values.find(Offset);
+  return I != Values.end() ? I->second.Delegate : ValueDelegate();
+}
+
+void EngineValue::splitAt(uint64_t Offset) {
+  auto I = Values.upper_bound(Offset);
+  if (I == Values.begin())
+    return;
+  --I;
+
+  uint64_t Begin = I->first, End = I->first + I->second.Size;
+  if (Begin == Offset || End <= Offset)
+    return;
+
+  I->second = {Offset - Begin, ValueDelegate()};
+  Values.emplace_hint(std::next(I), Offset, Fragment{End - Offset, ValueDelegate()});
+}
+
+EngineValue::FragmentIterator EngineValue::eraseRange(uint64_t Offset, uint64_t Size) {
+  splitAt(Offset);
+  splitAt(Offset + Size);
+  return Values.erase(Values.lower_bound(Offset), Values.lower_bound(Offset + Size));
 }
 
-void EngineValue::setDelegate(uint64_t Offset, ValueDelegate &Delegate) {
-  Values[Offset] = Delegate;
+EngineValue::FragmentIterator EngineValue::mergeWithPrevious(FragmentIterator I) {
+  if (I == Values.begin() || I == Values.end() || I->second.Delegate.isValid())
+    return I;
+
+  auto Prev = std::prev(I);
+  if (Prev->second.Delegate.isValid() || Prev->first + Prev->second.Size != I->first)
+    return I;
+
+  Prev->second.Size += I->second.Size;
+  Values.erase(I);
+  return Prev;
+}
+
+void EngineValue::coalesce(uint64_t Begin, uint64_t End) {
+  auto I = Values.lower_bound(Begin);
+  if (I != Values.begin())
+    --I;
+
+  while (I != Values.end() && I->first <= End) {
+    auto Next = std::next(I);
+    if (Next == Values.end())
+      break;
+    auto Merged = mergeWithPrevious(Next);
+    if (Merged == Next)
+      I = Next;
+  }
+}
+
+bool EngineValue::contains(uint64_t Offset, uint64_t Size) const {
+  return Offset <= this->Size && Size <= this->Size - Offset;
+}
+
+bool EngineValue::store(uint64_t Offset, uint64_t Size, ValueDelegate Delegate) {
+  if (!contains(Offset, Size))
+    return false;
+  if (!Size)
+    return true;
+
+  Values.emplace_hint(eraseRange(Offset, Size), Offset, Fragment{Size, Delegate});
+  coalesce(Offset, Offset + Size);
+  return true;
+}
+
+bool EngineValue::store(const llvm::DataLayout &DL, uint64_t Offset, llvm::Type *Ty, ValueDelegate Delegate) {
+  return store(Offset, DL.getTypeStoreSize(Ty), Delegate);
+}
+
+ValueDelegate EngineValue::load(uint64_t Offset, uint64_t Size) const {
+  auto I = Values.find(Offset);
+  if (I == Values.end() || I->second.Size != Size)
+    return ValueDelegate();
+  return I->second.Delegate;
+}
+
+ValueDelegate EngineValue::load(const llvm::DataLayout &DL, uint64_t Offset, llvm::Type *Ty) const {
+  return load(Offset, DL.getTypeStoreSize(Ty));
+}
+
+bool EngineValue::copyRange(uint64_t DstOffset, const EngineValue &Src, uint64_t SrcOffset, uint64_t Size) {
+  if (!contains(DstOffset, Size) || !Src.contains(SrcOffset, Size))
+    return false;
+  if (!Size)
+    return true;
+
+  uint64_t SrcEnd = SrcOffset + Size;
+
+  /* Collect the fragments first, as the source range may overlap with the destination range */
+  llvm::SmallVector<std::pair<uint64_t, Fragment>, 8> Copied;
+  auto I = Src.Values.upper_bound(SrcOffset);
+  if (I != Src.Values.begin() && std::prev(I)->first + std::prev(I)->second.Size > SrcOffset)
+    --I;
+  for (; I != Src.Values.end() && I->first < SrcEnd; ++I) {
+    uint64_t Begin = std::max(I->first, SrcOffset);
+    uint64_t End = std::min(I->first + I->second.Size, SrcEnd);
+    bool Complete = Begin == I->first && End == I->first + I->second.Size;
+    Copied.push_back({Begin - SrcOffset, {End - Begin, Complete ? I->second.Delegate : ValueDelegate()}});
+  }
+
+  auto Hint = eraseRange(DstOffset, Size);
+  for (const auto &Entry : Copied)
+    Values.emplace_hint(Hint, DstOffset + Entry.first, Entry.second);
+  coalesce(DstOffset, DstOffset + Size);
+  return true;
 }
 
 } // namespace icarus
\ No newline at end of file
@@ -64,7 +64,7 @@ void ExecutionEngine::executeFunctionsInSection(llvm::Module *M, llvm::StringRef
     if (!CS)
       continue;
     llvm::Constant *FP = CS->getOperand(1);
-    if (!FP->isNullValue())
+    if (FP->isNullValue())
       continue;
 
     if (llvm::ConstantExpr *CE = llvm::dyn_cast<llvm::ConstantExpr>(FP))
@@ -0,0 +1,125 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Analysis/FramePool.h>
+
+#include <algorithm>
+
+namespace icarus {
+
+/*
+ * The pool of a thread is destroyed before static objects of the main thread, which might still hold
+ * call frames. Storages released after that point are freed directly instead of accessing the pool.
+ */
+static thread_local bool FramePoolDestroyed = false;
+
+/*
+ * FrameStorage methods
+ */
+
+FrameStorage::FrameStorage(unsigned Size) : FrameStorage(FramePool::get().acquire(Size)) {}
+
+FrameStorage::FrameStorage(const FrameStorage &Other) : FrameStorage(Other.Size) {
+  std::copy(Other.Data, Other.Data + Other.Size, Data);
+}
+
+FrameStorage::FrameStorage(FrameStorage &&Other) noexcept
+    : Data(Other.Data), Size(Other.Size), Capacity(Other.Capacity) {
+  Other.Data = nullptr;
+  Other.Size = Other.Capacity = 0;
+}
+
+FrameStorage::~FrameStorage() {
+  reset();
+}
+
+void FrameStorage::reset() {
+  if (!Data)
+    return;
+  if (FramePoolDestroyed) {
+    delete[] Data;
+    Data = nullptr;
+    Size = Capacity = 0;
+  } else {
+    FramePool::get().release(*this);
+  }
+}
+
+FrameStorage &FrameStorage::operator=(const FrameStorage &Other) {
+  if (this != &Other)
+    *this = FrameStorage(Other);
+  return *this;
+}
+
+FrameStorage &FrameStorage::operator=(FrameStorage &&Other) noexcept {
+  if (this != &Other) {
+    reset();
+    Data = Other.Data;
+    Size = Other.Size;
+    Capacity = Other.Capacity;
+    Other.Data = nullptr;
+    Other.Size = Other.Capacity = 0;
+  }
+  return *this;
+}
+
+/*
+ * FramePool methods
+ */
+
+FramePool::~FramePool() {
+  FramePoolDestroyed = true;
+}
+
+unsigned FramePool::getBucket(unsigned Capacity) {
+  unsigned Bucket = 0;
+  while ((1U << (Bucket + MinCapacityLog2)) < Capacity)
+    ++Bucket;
+  return Bucket;
+}
+
+FramePool &FramePool::get() {
+  static thread_local FramePool Pool;
+  return Pool;
+}
+
+FrameStorage FramePool::acquire(unsigned Size) {
+  if (!Size)
+    return FrameStorage();
+
+  unsigned Bucket = getBucket(Size);
+  unsigned Capacity = 1U << (Bucket + MinCapacityLog2);
+  ++Acquired;
+
+  if (Bucket < NumBuckets && !FreeLists[Bucket].empty()) {
+    ValueDelegate *Data = FreeLists[Bucket].back().release();
+    FreeLists[Bucket].pop_back();
+    std::fill(Data, Data + Size, ValueDelegate());
+    ++Reused;
+    return FrameStorage(Data, Size, Capacity);
+  }
+
+  return FrameStorage(new ValueDelegate[Capacity], Size, Capacity);
+}
+
+void FramePool::release(FrameStorage &Storage) {
+  unsigned Bucket = getBucket(Storage.Capacity);
+  if (Bucket < NumBuckets && FreeLists[Bucket].size() < MaxFreeFrames)
+    FreeLists[Bucket].emplace_back(Storage.Data);
+  else
+    delete[] Storage.Data;
+
+  Storage.Data = nullptr;
+  Storage.Size = Storage.Capacity = 0;
+}
+
+std::size_t FramePool::getNumAcquired() const {
+  return Acquired;
+}
+
+std::size_t FramePool::getNumReused() const {
+  return Reused;
+}
+
+} // namespace icarus
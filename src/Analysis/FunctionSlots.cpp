@@ -0,0 +1,104 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <llvm/IR/ValueMap.h>
+
+#include <icarus/Analysis/FunctionSlots.h>
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+namespace icarus {
+
+/**
+ * Configuration for the cache of all FunctionSlots. The llvm::ValueMap automatically removes the entry
+ * of a function once the function is deleted (e.g. if its module is freed), which requires the cache
+ * mutex to be held while doing so.
+ */
+struct FunctionSlotsConfig : llvm::ValueMapConfig<const llvm::Function *, std::shared_mutex> {
+  struct ExtraData {
+    std::shared_mutex *Mutex;
+  };
+
+  static std::shared_mutex *getMutex(const ExtraData &Data) {
+    return Data.Mutex;
+  }
+};
+
+/*
+ * FunctionSlots methods
+ */
+
+FunctionSlots::FunctionSlots(llvm::Function &F) {
+  for (llvm::Argument &A : F.args()) {
+    SlotMap[&A] = Values.size();
+    Values.push_back(&A);
+  }
+
+  for (llvm::BasicBlock &BB : F) {
+    for (llvm::Instruction &I : BB) {
+      SlotMap[&I] = Values.size();
+      Values.push_back(&I);
+    }
+  }
+
+  /* Operands may refer to instructions of later basic blocks, so we need all slots first */
+  OperandBegin.resize(Values.size() + 1, 0);
+  for (unsigned Slot = 0; Slot < Values.size(); ++Slot) {
+    OperandBegin[Slot] = OperandSlots.size();
+    if (auto *I = llvm::dyn_cast<llvm::Instruction>(Values[Slot])) {
+      for (llvm::Value *Operand : I->operands())
+        OperandSlots.push_back(getSlot(Operand));
+    }
+  }
+  OperandBegin[Values.size()] = OperandSlots.size();
+}
+
+const FunctionSlots &FunctionSlots::get(llvm::Function &F) {
+  static std::shared_mutex Mutex;
+  static llvm::ValueMap<const llvm::Function *, std::unique_ptr<FunctionSlots>, FunctionSlotsConfig> Cache(
+      FunctionSlotsConfig::ExtraData{&Mutex});
+
+  {
+    std::shared_lock<std::shared_mutex> Lock(Mutex);
+    auto I = Cache.find(&F);
+    if (I != Cache.end())
+      return *I->second;
+  }
+
+  /* Number the function outside of the lock, another thread might have been faster though */
+  auto Slots = std::make_unique<FunctionSlots>(F);
+  std::unique_lock<std::shared_mutex> Lock(Mutex);
+  auto &Entry = Cache[&F];
+  if (!Entry)
+    Entry = std::move(Slots);
+  return *Entry;
+}
+
+unsigned FunctionSlots::getNumSlots() const {
+  return Values.size();
+}
+
+int FunctionSlots::getSlot(const llvm::Value *V) const {
+  auto I = SlotMap.find(V);
+  return I != SlotMap.end() ? static_cast<int>(I->second) : -1;
+}
+
+llvm::Value *FunctionSlots::getValue(unsigned Slot) const {
+  return Values[Slot];
+}
+
+llvm::ArrayRef<int> FunctionSlots::getOperandSlots(const llvm::Instruction &I) const {
+  int Slot = getSlot(&I);
+  if (Slot < 0)
+    return {};
+  return getOperandSlots(static_cast<unsigned>(Slot));
+}
+
+llvm::ArrayRef<int> FunctionSlots::getOperandSlots(unsigned Slot) const {
+  return llvm::ArrayRef<int>(OperandSlots).slice(OperandBegin[Slot], OperandBegin[Slot + 1] - OperandBegin[Slot]);
+}
+
+} // namespace icarus
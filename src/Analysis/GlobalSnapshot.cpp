@@ -0,0 +1,31 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Analysis/GlobalSnapshot.h>
+
+namespace icarus {
+
+/*
+ * GlobalSnapshot methods
+ */
+
+std::size_t GlobalSnapshot::getNumEngineValues() const {
+  return EngineValues.size();
+}
+
+const EngineValue *GlobalSnapshot::getEngineValue(llvm::Value *Base) const {
+  return EngineValues.lookup(Base);
+}
+
+llvm::Value *GlobalSnapshot::getNamedValue(const std::string &Name) const {
+  llvm::Value *const *V = NamedValues.lookup(Name);
+  return V ? *V : nullptr;
+}
+
+llvm::Value *GlobalSnapshot::getAddressableValue(uint64_t Address) const {
+  llvm::Value *const *V = AddressableValues.lookup(Address);
+  return V ? *V : nullptr;
+}
+
+} // namespace icarus
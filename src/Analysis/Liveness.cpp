@@ -0,0 +1,65 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <llvm/IR/Instructions.h>
+
+#include <icarus/Analysis/Liveness.h>
+
+namespace icarus {
+
+/*
+ * LivenessAnalysis methods
+ */
+
+LivenessAnalysis::LivenessAnalysis(llvm::Function &F) : Slots(FunctionSlots::get(F)) {}
+
+LivenessAnalysis::DomainT LivenessAnalysis::getInitial(llvm::BasicBlock &/*BB*/) const {
+  return DomainT(Slots.getNumSlots());
+}
+
+LivenessAnalysis::DomainT LivenessAnalysis::getBoundary(llvm::BasicBlock &/*Exit*/) const {
+  return DomainT(Slots.getNumSlots());
+}
+
+void LivenessAnalysis::meet(DomainT &Out, llvm::BasicBlock &BB, llvm::BasicBlock &Succ, const DomainT &SuccIn) const {
+  Out |= SuccIn;
+  for (llvm::Instruction &I : Succ) {
+    auto *Phi = llvm::dyn_cast<llvm::PHINode>(&I);
+    if (!Phi)
+      break;
+    int Slot = Slots.getSlot(Phi->getIncomingValueForBlock(&BB));
+    if (Slot >= 0)
+      Out.set(Slot);
+  }
+}
+
+bool LivenessAnalysis::transfer(llvm::BasicBlock &BB, const DomainT &Out, DomainT &In) const {
+  DomainT Live = Out;
+  for (llvm::Instruction &I : llvm::reverse(BB)) {
+    int Slot = Slots.getSlot(&I);
+    if (Slot < 0)
+      continue;
+    Live.reset(Slot);
+
+    /* Operands of PHI nodes are live at the end of the incoming blocks (see meet) */
+    if (llvm::isa<llvm::PHINode>(I))
+      continue;
+
+    for (int OperandSlot : Slots.getOperandSlots(static_cast<unsigned>(Slot)))
+      if (OperandSlot >= 0)
+        Live.set(OperandSlot);
+  }
+
+  if (Live == In)
+    return false;
+  In = std::move(Live);
+  return true;
+}
+
+bool LivenessAnalysis::isLive(const DomainT &Live, const llvm::Value *V) const {
+  int Slot = Slots.getSlot(V);
+  return Slot >= 0 && Live.test(Slot);
+}
+
+} // namespace icarus
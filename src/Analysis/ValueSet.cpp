@@ -0,0 +1,259 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <icarus/Analysis/ValueSet.h>
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <unordered_map>
+
+namespace icarus {
+
+namespace {
+
+/**
+ * Global table of all interned value sets. The table only holds weak references to the sets, so that
+ * the storage is deallocated once no ValueSet refers to it anymore. Expired entries are purged lazily
+ * during lookups. Both the table and the union cache are split into shards to reduce lock contention
+ * when multiple worker threads merge sets at the same time.
+ */
+class ValueSetInterner {
+
+  static constexpr unsigned NumShards = 16;
+  static constexpr unsigned NumUnionEntries = 256;
+
+  using StoragePtr = std::shared_ptr<const ValueSetStorage>;
+  using WeakStoragePtr = std::weak_ptr<const ValueSetStorage>;
+
+  struct UnionEntry {
+    WeakStoragePtr LHS;
+    WeakStoragePtr RHS;
+    WeakStoragePtr Result;
+  };
+
+  struct Shard {
+    std::mutex Mutex;
+    std::unordered_multimap<std::size_t, WeakStoragePtr> Sets;
+    std::size_t PurgeThreshold = 1024;
+    std::array<UnionEntry, NumUnionEntries> Unions;
+  };
+
+  std::array<Shard, NumShards> Shards;
+
+  /**
+   * Removes all expired entries in the shard, once the number of entries exceeds the threshold.
+   */
+  static void purge(Shard &S) {
+    if (S.Sets.size() < S.PurgeThreshold)
+      return;
+    for (auto I = S.Sets.begin(); I != S.Sets.end();)
+      I = I->second.expired() ? S.Sets.erase(I) : std::next(I);
+    S.PurgeThreshold = std::max<std::size_t>(1024, S.Sets.size() * 2);
+  }
+
+  static std::size_t unionSlot(const ValueSetStorage *LHS, const ValueSetStorage *RHS) {
+    return llvm::hash_combine(LHS, RHS);
+  }
+
+public:
+  static ValueSetInterner &get() {
+    static ValueSetInterner Interner;
+    return Interner;
+  }
+
+  /**
+   * Returns the unique storage for the provided sorted elements.
+   */
+  StoragePtr intern(llvm::ArrayRef<ValueDelegate> Elements, std::size_t Hash) {
+    Shard &S = Shards[Hash % NumShards];
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+
+    auto [Begin, End] = S.Sets.equal_range(Hash);
+    for (auto I = Begin; I != End;) {
+      StoragePtr Storage = I->second.lock();
+      if (!Storage) {
+        I = S.Sets.erase(I);
+        continue;
+      }
+      if (llvm::ArrayRef<ValueDelegate>(Storage->Elements) == Elements)
+        return Storage;
+      ++I;
+    }
+
+    purge(S);
+    auto Storage = std::make_shared<const ValueSetStorage>(ValueSetStorage{Hash, Elements.vec()});
+    S.Sets.emplace(Hash, Storage);
+    return Storage;
+  }
+
+  /**
+   * Look up the memoized union of two interned sets.
+   * @return The interned union or nullptr, if the union has not been memoized.
+   */
+  StoragePtr lookupUnion(const StoragePtr &LHS, const StoragePtr &RHS) {
+    std::size_t Slot = unionSlot(LHS.get(), RHS.get());
+    Shard &S = Shards[Slot % NumShards];
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    UnionEntry &E = S.Unions[(Slot / NumShards) % NumUnionEntries];
+    if (E.LHS.lock() != LHS || E.RHS.lock() != RHS)
+      return nullptr;
+    return E.Result.lock();
+  }
+
+  void storeUnion(const StoragePtr &LHS, const StoragePtr &RHS, const StoragePtr &Result) {
+    std::size_t Slot = unionSlot(LHS.get(), RHS.get());
+    Shard &S = Shards[Slot % NumShards];
+    std::lock_guard<std::mutex> Lock(S.Mutex);
+    S.Unions[(Slot / NumShards) % NumUnionEntries] = {LHS, RHS, Result};
+  }
+};
+
+} // namespace
+
+/*
+ * ValueSet methods
+ */
+
+ValueSet::ValueSet(const ValueDelegate &Delegate) {
+  if (!Delegate.isValid())
+    Unknown = true;
+  else
+    Inline.push_back(Delegate);
+}
+
+ValueSet::ValueSet(llvm::ArrayRef<ValueDelegate> Delegates) {
+  llvm::SmallVector<ValueDelegate, 8> Elements;
+  for (const ValueDelegate &Delegate : Delegates) {
+    if (!Delegate.isValid()) {
+      Unknown = true;
+      return;
+    }
+    Elements.push_back(Delegate);
+  }
+
+  std::sort(Elements.begin(), Elements.end());
+  Elements.erase(std::unique(Elements.begin(), Elements.end()), Elements.end());
+  *this = fromSorted(Elements);
+}
+
+ValueSet ValueSet::fromSorted(llvm::ArrayRef<ValueDelegate> Elements) {
+  ValueSet Set;
+  if (Elements.size() <= InlineSize) {
+    Set.Inline.append(Elements.begin(), Elements.end());
+    return Set;
+  }
+
+  std::size_t Hash = llvm::hash_combine_range(Elements.begin(), Elements.end());
+  Set.Shared = ValueSetInterner::get().intern(Elements, Hash);
+  return Set;
+}
+
+ValueSet ValueSet::getUnknown() {
+  ValueSet Set;
+  Set.Unknown = true;
+  return Set;
+}
+
+bool ValueSet::isUnknown() const {
+  return Unknown;
+}
+
+bool ValueSet::empty() const {
+  return !Unknown && elements().empty();
+}
+
+std::size_t ValueSet::size() const {
+  return elements().size();
+}
+
+llvm::ArrayRef<ValueDelegate> ValueSet::elements() const {
+  if (Shared)
+    return Shared->Elements;
+  return Inline;
+}
+
+bool ValueSet::contains(const ValueDelegate &Delegate) const {
+  llvm::ArrayRef<ValueDelegate> Elements = elements();
+  return std::binary_search(Elements.begin(), Elements.end(), Delegate);
+}
+
+ValueDelegate ValueSet::getUniqueDelegate() const {
+  return !Unknown && size() == 1 ? elements().front() : ValueDelegate();
+}
+
+ValueSet ValueSet::merge(const ValueSet &Other) const {
+  if (Unknown || Other.empty())
+    return *this;
+  if (Other.Unknown || empty())
+    return Other;
+  if (Shared && Shared == Other.Shared)
+    return *this;
+
+  /* Unions are commutative, so we normalize the order for the union cache */
+  bool Memoize = Shared && Other.Shared;
+  const ValueSet &LHS = !Memoize || Shared < Other.Shared ? *this : Other;
+  const ValueSet &RHS = &LHS == this ? Other : *this;
+  if (Memoize) {
+    if (auto Union = ValueSetInterner::get().lookupUnion(LHS.Shared, RHS.Shared)) {
+      ValueSet Set;
+      Set.Shared = std::move(Union);
+      return Set;
+    }
+  }
+
+  llvm::ArrayRef<ValueDelegate> L = LHS.elements(), R = RHS.elements();
+  llvm::SmallVector<ValueDelegate, 16> Elements;
+  Elements.reserve(L.size() + R.size());
+  std::set_union(L.begin(), L.end(), R.begin(), R.end(), std::back_inserter(Elements));
+
+  /* Avoid interning a set that is equal to one of the operands */
+  if (Elements.size() == L.size())
+    return LHS;
+  if (Elements.size() == R.size())
+    return RHS;
+
+  ValueSet Set = fromSorted(Elements);
+  if (Memoize)
+    ValueSetInterner::get().storeUnion(LHS.Shared, RHS.Shared, Set.Shared);
+  return Set;
+}
+
+bool ValueSet::mergeWith(const ValueSet &Other) {
+  ValueSet Merged = merge(Other);
+  if (Merged == *this)
+    return false;
+  *this = std::move(Merged);
+  return true;
+}
+
+bool ValueSet::insert(const ValueDelegate &Delegate) {
+  return mergeWith(ValueSet(Delegate));
+}
+
+bool ValueSet::isInterned() const {
+  return Shared != nullptr;
+}
+
+bool ValueSet::operator==(const ValueSet &Other) const {
+  if (Unknown || Other.Unknown)
+    return Unknown == Other.Unknown;
+  if (Shared || Other.Shared)
+    return Shared == Other.Shared;
+  return llvm::ArrayRef<ValueDelegate>(Inline) == llvm::ArrayRef<ValueDelegate>(Other.Inline);
+}
+
+bool ValueSet::operator!=(const ValueSet &Other) const {
+  return !(*this == Other);
+}
+
+llvm::hash_code hash_value(const ValueSet &Set) {
+  if (Set.Unknown)
+    return llvm::hash_value(true);
+  if (Set.Shared)
+    return Set.Shared->Hash;
+  return llvm::hash_combine_range(Set.Inline.begin(), Set.Inline.end());
+}
+
+} // namespace icarus
@@ -27,6 +27,42 @@ cl::opt<std::string> File("file", cl::desc("Bitcode (.bc, .ll), text (.txt)"), c
 cl::opt<std::string> JSON("json", cl::desc("Path to JSON file for pass-specific arguments"), cl::cat(IcarusCategory));
 
 cl::opt<unsigned> Threads("threads", cl::desc("Number of threads to run in thread pool"), cl::cat(IcarusCategory));
+cl::opt<std::string> PinThreads("pin-threads", cl::desc("Pin the threads to a list of CPUs (e.g. 0-3,8)"),
+                                cl::cat(IcarusCategory));
+cl::opt<unsigned> SpinRounds("spin-rounds", cl::desc("Attempts of idle threads to find a task before they sleep"),
+                             cl::init(ThreadPool::IdleOptions().SpinRounds), cl::cat(IcarusCategory));
+cl::opt<unsigned> LoadThreads("load-threads", cl::desc("Number of threads to load the modules in parallel"),
+                              cl::init(1), cl::cat(IcarusCategory));
+
+cl::opt<SchedulingPolicy> Schedule("schedule", cl::desc("Order of pending program states"),
+                                   cl::values(clEnumValN(SchedulingPolicy::DFS, "dfs", "Depth-first (default)"),
+                                              clEnumValN(SchedulingPolicy::BFS, "bfs", "Breadth-first"),
+                                              clEnumValN(SchedulingPolicy::Coverage, "coverage", "Least covered block"),
+                                              clEnumValN(SchedulingPolicy::ShortestStack, "shortest-stack",
+                                                         "Fewest call frames")),
+                                   cl::init(SchedulingPolicy::DFS), cl::cat(IcarusCategory));
+
+/*
+ * In deterministic mode, threaded analyses execute their tasks in rounds and merge results and logs in
+ * the order of stable task IDs. Two runs with the same -threads and -seed produce identical output.
+ */
+
+cl::opt<bool> Deterministic("deterministic", cl::desc("Produce reproducible results and logs"),
+                            cl::cat(IcarusCategory));
+cl::opt<uint64_t> Seed("seed", cl::desc("Seed for randomized choices of the analysis"), cl::init(0),
+                       cl::cat(IcarusCategory));
+
+/*
+ * Long-running analyses periodically write their pending program states into a checkpoint file. With
+ * the -resume option, the analysis continues from the states in the checkpoint file.
+ */
+
+cl::OptionCategory CheckpointCategory("Checkpoint options for icarus");
+cl::opt<std::string> CheckpointFile("checkpoint", cl::desc("File in which to save checkpoints"),
+                                    cl::cat(CheckpointCategory));
+cl::opt<unsigned> CheckpointInterval("checkpoint-interval", cl::desc("Seconds between checkpoints"), cl::init(600),
+                                     cl::cat(CheckpointCategory));
+cl::opt<bool> Resume("resume", cl::desc("Resume the analysis from the checkpoint file"), cl::cat(CheckpointCategory));
 
 /*
  * Usually, we would be using the internal structs from LLVM for managing the -debug and -debug-only
@@ -46,7 +82,7 @@ cl::opt<std::string> DebugFile("debug-file", cl::desc("File in which to save log
 } // namespace icarus
 
 int main(int argc, char *argv[]) {
-  std::vector<cl::OptionCategory *> OptionCategories{&IcarusCategory, &DebugCategory};
+  std::vector<cl::OptionCategory *> OptionCategories{&IcarusCategory, &CheckpointCategory, &DebugCategory};
   PassRegistry::populateOptionCategories(OptionCategories);
   cl::HideUnrelatedOptions(OptionCategories);
 
@@ -57,13 +93,29 @@ int main(int argc, char *argv[]) {
   if (!IP)
     return EINVAL;
 
-  PassArguments IPA(File.getValue(), JSON.getValue(), Threads.getValue());
+  /* Threads are pinned before the modules are loaded, as the loaders are pinned to the same CPUs */
+  if (!PinThreads.empty()) {
+    std::optional<std::vector<unsigned>> CPUs = parseCPUList(PinThreads.getValue());
+    if (!CPUs || !ThreadPool::pinThreads(*CPUs))
+      return EINVAL;
+  }
+
+  ThreadPool::IdleOptions Idle;
+  Idle.SpinRounds = SpinRounds.getValue();
+  ThreadPool::setIdleOptions(Idle);
+
+  PassArguments IPA(File.getValue(), JSON.getValue(), Threads.getValue(), LoadThreads.getValue());
   if (!IPA.getNumFiles())
     return ENOENT;
 
+  IPA.setCheckpointOptions(CheckpointFile.getValue(), CheckpointInterval.getValue(), Resume.getValue());
+  IPA.setSchedulingPolicy(Schedule.getValue());
+  IPA.setDeterministicOptions(Deterministic.getValue(), Seed.getValue());
+
   if (!IP->checkPassArguments(IPA))
     return EINVAL;
 
+  logger::setDeterministicOutput(Deterministic.getValue());
   logger::initLoggerOptions(DebugOnly, DebugFile);
 
   ICARUS_INFO_WITH("init", "Start icarus...");
@@ -78,6 +130,15 @@ int main(int argc, char *argv[]) {
 
   int Ret = IP->runAnalysisPass(IPA);
 
+  if (!PinThreads.empty()) {
+    std::vector<ThreadPool::NodeStatistics> Statistics = ThreadPool::getNodeStatistics();
+    for (unsigned Node = 0; Node < Statistics.size(); ++Node) {
+      ThreadPool::NodeStatistics &S = Statistics[Node];
+      ICARUS_INFO_WITH("threads", "Node ", Node, ": ", S.Workers, " workers, ", S.LocalTasks, " local tasks, ",
+                       S.RemoteTasks, " remote tasks");
+    }
+  }
+
   logger::waitFinished();
   ThreadPool::shutdown();
 
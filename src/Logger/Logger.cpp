@@ -67,6 +67,34 @@ void LogThread::shutdown() {
   delete Logger;
 }
 
+/*
+ * LogBuffer methods
+ */
+
+static thread_local LogBuffer *CurrentBuffer = nullptr;
+
+LogBuffer::LogBuffer() : Parent(CurrentBuffer) {
+  CurrentBuffer = this;
+}
+
+LogBuffer::~LogBuffer() {
+  CurrentBuffer = Parent;
+  for (LogMessage &Message : Messages)
+    logMessage(std::move(Message));
+}
+
+LogBuffer *LogBuffer::getCurrent() {
+  return CurrentBuffer;
+}
+
+void LogBuffer::add(LogMessage &&Message) {
+  Messages.push_back(std::move(Message));
+}
+
+std::vector<LogMessage> LogBuffer::take() {
+  return std::exchange(Messages, {});
+}
+
 /*
  * Logger methods
  */
@@ -74,7 +102,21 @@ void LogThread::shutdown() {
 std::vector<LogThread *> Loggers;
 std::vector<LogMessage> EarlyMessages;
 
+static std::atomic<bool> DeterministicOutput{false};
+
+void setDeterministicOutput(bool Enable) {
+  DeterministicOutput = Enable;
+}
+
+bool isDeterministicOutput() {
+  return DeterministicOutput;
+}
+
 void logMessage(LogMessage &&Message) {
+  if (LogBuffer *Buffer = LogBuffer::getCurrent()) {
+    Buffer->add(std::move(Message));
+    return;
+  }
   for (LogThread *L : Loggers) {
     L->logs(Message.LogType, Message.Message);
   }
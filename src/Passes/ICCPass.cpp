@@ -10,6 +10,8 @@
 
 #include <icarus/Passes/ICCPass.h>
 
+#include <icarus/Threads/TaskGroup.h>
+
 namespace icarus::passes {
 
 /*
@@ -23,27 +25,48 @@ static RegisterPass<ICCPass> ICCPass(nullptr);
  */
 
 bool ICCPass::checkPassArguments(PassArguments &IPA) {
+  ThreadPool::initialize(IPA.getNumThreads());
   return true;
 }
 
-int ICCPass::runAnalysisPass(PassArguments &IPA) {
-  std::for_each(IPA.begin(), IPA.end(), [&](IcarusModule &IM) {
-    llvm::Module *M = IM.getModule();
-    for (llvm::Function &F : *M) {
+/**
+ * @param F The function to analyze.
+ * @return The number of indirect calls in the function.
+ */
+static unsigned long countIndirectCalls(llvm::Function &F) {
 #if ICARUS_CLANG_VERSION >= 8
-      IndirectCalls[IM.getFilePath()] += llvm::findIndirectCalls(F).size();
+  return llvm::findIndirectCalls(F).size();
 #else
-      for (llvm::BasicBlock &BB : F) {
-        for (llvm::Instruction &I : BB) {
-          if (llvm::CallInst *C = llvm::dyn_cast<llvm::CallInst>(&I)) {
-            if (!C->getCalledFunction())
-              IndirectCalls[IM.getFilePath()]++;
-          }
-        }
+  unsigned long Count = 0;
+  for (llvm::BasicBlock &BB : F) {
+    for (llvm::Instruction &I : BB) {
+      if (llvm::CallInst *C = llvm::dyn_cast<llvm::CallInst>(&I)) {
+        if (!C->getCalledFunction())
+          Count++;
       }
-#endif
     }
-  });
+  }
+  return Count;
+#endif
+}
+
+int ICCPass::runAnalysisPass(PassArguments &IPA) {
+  /* Modules are counted on the node they have been loaded on, and the functions of each module in parallel */
+  std::vector<unsigned long> Counts(IPA.getNumFiles());
+  TaskGroup Group;
+  for (unsigned N = 0; N < Counts.size(); ++N) {
+    IcarusModule *IM = IPA.getModuleAt(N);
+    Group.runOnNode(IM->getNode(), [&Counts, IM, N]() {
+      llvm::Module *M = IM->getModule();
+      Counts[N] = ThreadPool::parallelReduce(
+          M->begin(), M->end(), 0UL, [](unsigned long &Count, llvm::Function &F) { Count += countIndirectCalls(F); },
+          [](unsigned long &Count, unsigned long Other) { Count += Other; });
+    });
+  }
+  Group.wait();
+
+  for (unsigned N = 0; N < Counts.size(); ++N)
+    IndirectCalls[IPA.getModuleAt(N)->getFilePath()] += Counts[N];
 
   for (auto &[Path, Count] : IndirectCalls) {
     ICARUS_INFO(Path, ": ", Count);
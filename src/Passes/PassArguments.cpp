@@ -16,6 +16,8 @@
 #include "icarus/Support/LLVMValue.h"
 #include "icarus/Support/String.h"
 
+#include "icarus/Threads/ThreadPool.h"
+
 #include "nlohmann/json.hpp"
 
 #include <fstream>
@@ -65,7 +67,7 @@ void from_json(const nlohmann::json &JSON, InputArguments &IA, IcarusModule *IM)
  * IcarusModule methods
  */
 
-IcarusModule::IcarusModule(std::string const &FilePath) : FilePath(FilePath) {
+IcarusModule::IcarusModule(std::string const &FilePath) : FilePath(FilePath), Node(ThreadPool::getCurrentNode()) {
   FileName = llvm::StringRef(FilePath).rsplit('/').second;
   IRModule = llvm::parseIRFile(FilePath, Err, Context);
 }
@@ -86,6 +88,10 @@ llvm::SMDiagnostic &IcarusModule::getDiagnostics() {
   return Err;
 }
 
+unsigned IcarusModule::getNode() const {
+  return Node;
+}
+
 llvm::Type *IcarusModule::parseType(const nlohmann::json &JSON) {
   llvm::Type *T;
 
@@ -159,7 +165,8 @@ llvm::Function *IcarusModule::parseFunction(const nlohmann::json &JSON) {
  * PassArguments methods
  */
 
-PassArguments::PassArguments(std::string const &FileArg, std::string const &JSONArg, unsigned NumThreads)
+PassArguments::PassArguments(std::string const &FileArg, std::string const &JSONArg, unsigned NumThreads,
+                             unsigned NumLoadThreads)
     : FileArg(FileArg), JSONArg(JSONArg), NumThreads(NumThreads) {
   /*
    * First, check if the input files exists and parse all potential LLVM modules
@@ -173,18 +180,28 @@ PassArguments::PassArguments(std::string const &FileArg, std::string const &JSON
    * The plain text files contain the locations of one or more LLVM files. These
    * can then be used to perform analyses that require two or more files.
    */
+  std::vector<std::string> FilePaths;
   if (endsWith(FileArg, ".bc") || endsWith(FileArg, ".ll")) {
-    insertModule(FileArg);
+    FilePaths.push_back(FileArg);
   } else if (endsWith(FileArg, ".txt")) {
     std::ifstream InputFile(FileArg);
     std::string FileLine;
     while (std::getline(InputFile, FileLine)) {
-      insertModule(FileLine);
+      FilePaths.push_back(FileLine);
     }
     InputFile.close();
   }
 
-  Modules.shrink_to_fit();
+  /*
+   * Parsing is independent for each module (every module has its own context), so the modules are
+   * loaded by a separate pool. Its threads exit before the analysis starts in the default pool. The
+   * loaders are pinned to the CPUs of the default pool, so that the memory of each module is allocated
+   * on the node of the thread which parsed it, and the module records this node.
+   */
+  ThreadPool Loaders(NumLoadThreads, ThreadPool::getDefault());
+  Modules.resize(FilePaths.size());
+  Loaders.doParallelFor(
+      0UL, FilePaths.size(), [&](std::size_t N) { Modules[N] = std::make_unique<IcarusModule>(FilePaths[N]); }, 1);
 
   /*
    * Secondly, we check if a JSON file has been provided. If there is one, we try
@@ -205,12 +222,6 @@ PassArguments::PassArguments(std::string const &FileArg, std::string const &JSON
   JSONStream.close();
 }
 
-void PassArguments::insertModule(std::string const &FilePath) {
-  if (auto M = std::make_unique<IcarusModule>(FilePath)) {
-    Modules.push_back(std::move(M));
-  }
-}
-
 std::string PassArguments::getFile() const {
   return FileArg;
 }
@@ -231,6 +242,45 @@ nlohmann::json &PassArguments::getJSONObject() {
   return JSON;
 }
 
+void PassArguments::setCheckpointOptions(std::string const &File, unsigned Interval, bool Resume) {
+  CheckpointFile = File;
+  CheckpointInterval = Interval;
+  this->Resume = Resume;
+}
+
+std::string PassArguments::getCheckpointFile() const {
+  return CheckpointFile;
+}
+
+unsigned PassArguments::getCheckpointInterval() const {
+  return CheckpointInterval;
+}
+
+bool PassArguments::shouldResume() const {
+  return Resume;
+}
+
+void PassArguments::setSchedulingPolicy(SchedulingPolicy NewPolicy) {
+  Policy = NewPolicy;
+}
+
+SchedulingPolicy PassArguments::getSchedulingPolicy() const {
+  return Policy;
+}
+
+void PassArguments::setDeterministicOptions(bool Enable, uint64_t Seed) {
+  Deterministic = Enable;
+  this->Seed = Seed;
+}
+
+bool PassArguments::isDeterministic() const {
+  return Deterministic;
+}
+
+uint64_t PassArguments::getSeed() const {
+  return Seed;
+}
+
 IcarusModule *PassArguments::getModule(std::string_view Name) {
   for (auto const &M : Modules)
     if (M->getFileName() == Name)
@@ -250,4 +300,11 @@ PassArguments::iterator PassArguments::end() {
   return deref_iterator(Modules.end());
 }
 
+std::vector<llvm::Module *> PassArguments::getModules() {
+  std::vector<llvm::Module *> Result;
+  for (IcarusModule &IM : *this)
+    Result.push_back(IM.getModule());
+  return Result;
+}
+
 } // namespace icarus
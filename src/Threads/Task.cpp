@@ -0,0 +1,155 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "icarus/Threads/Task.h"
+
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace icarus {
+
+/*
+ * TaskAllocator methods
+ */
+
+namespace {
+
+struct FreeBlock {
+  FreeBlock *Next;
+};
+
+/**
+ * A singly-linked list of free blocks with its length.
+ */
+struct BlockList {
+  FreeBlock *Head = nullptr;
+  unsigned Size = 0;
+
+  void push(FreeBlock *Block) {
+    Block->Next = Head;
+    Head = Block;
+    ++Size;
+  }
+
+  FreeBlock *pop() {
+    FreeBlock *Block = Head;
+    Head = Block->Next;
+    --Size;
+    return Block;
+  }
+};
+
+/**
+ * Free blocks shared by all threads, stored as batches of TaskAllocator::BatchSize blocks.
+ */
+struct GlobalBlocks {
+  std::mutex Mutex;
+  std::vector<BlockList> Batches;
+
+  ~GlobalBlocks() {
+    for (BlockList &Batch : Batches)
+      while (Batch.Head)
+        ::operator delete(Batch.pop());
+  }
+};
+
+GlobalBlocks &getGlobalBlocks() {
+  static GlobalBlocks Blocks;
+  return Blocks;
+}
+
+/**
+ * Free blocks of the current thread, which are returned to the global list when the thread exits.
+ */
+struct LocalBlocks : public BlockList {
+  GlobalBlocks &Global = getGlobalBlocks();
+
+  ~LocalBlocks() {
+    if (!Head)
+      return;
+    std::lock_guard<std::mutex> Lock(Global.Mutex);
+    Global.Batches.push_back(*this);
+  }
+};
+
+thread_local LocalBlocks Local;
+
+} // namespace
+
+void *TaskAllocator::allocate(std::size_t Size) {
+  if (Size > BlockSize)
+    return ::operator new(Size);
+
+  if (!Local.Head) {
+    std::lock_guard<std::mutex> Lock(Local.Global.Mutex);
+    if (Local.Global.Batches.empty())
+      return ::operator new(BlockSize);
+    static_cast<BlockList &>(Local) = Local.Global.Batches.back();
+    Local.Global.Batches.pop_back();
+  }
+  return Local.pop();
+}
+
+void TaskAllocator::deallocate(void *Ptr, std::size_t Size) {
+  if (Size > BlockSize) {
+    ::operator delete(Ptr);
+    return;
+  }
+
+  Local.push(static_cast<FreeBlock *>(Ptr));
+  if (Local.Size < 2 * BatchSize)
+    return;
+
+  /* Keep one batch for the own allocations and hand over the other one */
+  BlockList Batch;
+  while (Batch.Size < BatchSize)
+    Batch.push(Local.pop());
+  std::lock_guard<std::mutex> Lock(Local.Global.Mutex);
+  Local.Global.Batches.push_back(Batch);
+}
+
+/*
+ * FutureStateBase methods
+ */
+
+namespace {
+
+struct alignas(64) ParkingSlot {
+  std::mutex Mutex;
+  std::condition_variable Condition;
+};
+
+std::array<ParkingSlot, 64> ParkingSlots;
+
+ParkingSlot &getParkingSlot(const void *Address) {
+  return ParkingSlots[(reinterpret_cast<std::uintptr_t>(Address) / TaskAllocator::BlockSize) % ParkingSlots.size()];
+}
+
+} // namespace
+
+namespace detail {
+
+void FutureStateBase::setReady() {
+  /* Threads set the waiting flag while holding the lock of the slot, so they cannot miss the notification */
+  if (!(Status.fetch_or(Ready, std::memory_order_acq_rel) & Waiting))
+    return;
+  ParkingSlot &Slot = getParkingSlot(this);
+  std::lock_guard<std::mutex> Lock(Slot.Mutex);
+  Slot.Condition.notify_all();
+}
+
+void FutureStateBase::wait() {
+  if (isReady())
+    return;
+  ParkingSlot &Slot = getParkingSlot(this);
+  std::unique_lock<std::mutex> Lock(Slot.Mutex);
+  Status.fetch_or(Waiting, std::memory_order_acq_rel);
+  Slot.Condition.wait(Lock, [&]() { return isReady(); });
+}
+
+} // namespace detail
+
+} // namespace icarus
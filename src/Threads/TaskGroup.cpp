@@ -0,0 +1,28 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "icarus/Threads/TaskGroup.h"
+
+namespace icarus {
+
+TaskGroup::~TaskGroup() {
+  Pool.doHelpUntilZero(Pending);
+}
+
+void TaskGroup::finish() {
+  /* The group may be destroyed by a waiting thread as soon as the counter is zero, so copy the pool first */
+  ThreadPool &P = Pool;
+  if (Pending.fetch_sub(1) == 1)
+    P.doNotifyHelpers();
+}
+
+void TaskGroup::wait() {
+  Pool.doHelpUntilZero(Pending);
+
+  std::lock_guard<std::mutex> Lock(ExceptionMutex);
+  if (std::exception_ptr E = std::exchange(Exception, nullptr))
+    std::rethrow_exception(E);
+}
+
+} // namespace icarus
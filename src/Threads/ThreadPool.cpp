@@ -4,82 +4,491 @@
 
 #include "icarus/Threads/ThreadPool.h"
 
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace icarus {
 
-ThreadPool &ThreadPool::get() {
-  static ThreadPool TP;
+/* The pool and deque index of the current thread, if it is a worker */
+static thread_local ThreadPool *CurrentPool = nullptr;
+static thread_local unsigned CurrentIndex = 0;
+
+/* Number of calls to ThreadPool::take in the current thread, for checking the lower priority lanes first */
+static thread_local unsigned TakeCount = 0;
+
+/**
+ * Hints the CPU that the current thread is spinning, so that it yields resources to its sibling hyper-thread.
+ */
+static inline void relaxCPU() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+/* Number of additional pools created so far, which determines the range of their thread IDs */
+static std::atomic_uint NumAdditionalPools = 0;
+
+ThreadPool::ThreadPool() : IDBase((NumAdditionalPools.fetch_add(1) + 1) * PoolIDRange) {}
+
+ThreadPool::ThreadPool(unsigned ThreadNum) : ThreadPool() {
+  doInitialize(ThreadNum);
+}
+
+ThreadPool::ThreadPool(unsigned ThreadNum, const ThreadPool &Pinning) : ThreadPool() {
+  CPUs = Pinning.CPUs;
+  CPUNodes = Pinning.CPUNodes;
+  NumNodes = Pinning.NumNodes;
+  doInitialize(ThreadNum);
+}
+
+ThreadPool::~ThreadPool() {
+  doShutdown();
+}
+
+ThreadPool &ThreadPool::getDefault() {
+  static ThreadPool TP{DefaultPoolTag()};
   return TP;
 }
 
-void ThreadPool::worker() {
+ThreadPool &ThreadPool::getCurrent() {
+  return CurrentPool ? *CurrentPool : getDefault();
+}
+
+unsigned ThreadPool::getCurrentThreadNum() {
+  return getCurrent().doGetThreadNum();
+}
+
+void ThreadPool::worker(unsigned Index) {
+  CurrentPool = this;
+  CurrentIndex = Index;
+  ThreadID = IDBase + Index + 1;
+  ThreadNode = WorkerNodes[Index];
+  uint32_t Seed = Index + 1;
+
+  if (!CPUs.empty())
+    pinCurrentThread(CPUs[(Index + 1) % CPUs.size()]);
+
+  unsigned Rounds = 0;
   while (Running) {
-    std::unique_ptr<Task> Task;
-    if (Tasks.pop(Task)) {
-      Task->execute();
-      --TotalTasks;
-      Condition.notify_one();
+    if (TaskPtr T = take(Index, Seed)) {
+      if (Rounds)
+        stopSpinning();
+      Rounds = 0;
+      execute(std::move(T));
+      continue;
+    }
+    idle(Rounds, nullptr);
+  }
+
+  if (Rounds)
+    SpinningThreads.fetch_sub(1);
+  CurrentPool = nullptr;
+  ThreadID = 0;
+  ThreadNode = 0;
+}
+
+TaskPtr ThreadPool::take(unsigned Index, uint32_t &Seed) {
+  TaskPtr T;
+  bool Remote = false;
+
+  /*
+   * High priority tasks are taken first and background tasks last. Periodically, the lower lanes are
+   * checked first instead, so that a steady stream of tasks in the higher lanes cannot starve them.
+   */
+  unsigned Tick = ++TakeCount;
+  if (Tick % BackgroundInterval == 0)
+    BackgroundTasks.tryPop(T);
+  if (!T && Tick % NormalInterval != 0)
+    HighTasks.tryPop(T);
+  if (!T)
+    T = takeNormal(Index, Seed, Remote);
+  if (!T)
+    HighTasks.tryPop(T);
+  if (!T)
+    BackgroundTasks.tryPop(T);
+
+  if (!T)
+    return T;
+
+  PendingTasks.fetch_sub(1);
+  if (Index < Deques.size()) {
+    std::atomic<uint64_t> &Counter = Remote ? Statistics[Index].Remote : Statistics[Index].Local;
+    Counter.store(Counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+  return T;
+}
+
+TaskPtr ThreadPool::takeNormal(unsigned Index, uint32_t &Seed, bool &Remote) {
+  Task *Raw = nullptr;
+  TaskPtr T;
+
+  if (Index < Deques.size() && Deques[Index]->pop(Raw))
+    return TaskPtr(Raw);
+  if ((!NodeTasks.empty() && NodeTasks[ThreadNode]->tryPop(T)) || Tasks.tryPop(T))
+    return T;
+
+  /* Start at a random victim, so that idle workers do not all steal from the same deque */
+  Seed ^= Seed << 13;
+  Seed ^= Seed >> 17;
+  Seed ^= Seed << 5;
+
+  /* Tasks of other nodes are only taken if there are no tasks left on the own node */
+  T = steal(Index, Seed, true);
+  if (!T && !NodeTasks.empty()) {
+    Remote = true;
+    for (unsigned N = 0; N < NodeTasks.size() && !T; ++N)
+      if (N != ThreadNode)
+        NodeTasks[N]->tryPop(T);
+    if (!T)
+      T = steal(Index, Seed, false);
+  }
+  return T;
+}
+
+TaskPtr ThreadPool::steal(unsigned Index, uint32_t Seed, bool SameNode) {
+  Task *Raw = nullptr;
+  for (unsigned N = 0; N < Deques.size(); ++N) {
+    unsigned Victim = (Seed + N) % Deques.size();
+    if (Victim == Index || (!NodeTasks.empty() && (WorkerNodes[Victim] == ThreadNode) != SameNode))
+      continue;
+    if (Deques[Victim]->steal(Raw))
+      return TaskPtr(Raw);
+  }
+  return nullptr;
+}
+
+void ThreadPool::schedule(TaskPtr T, unsigned Node, TaskPriority Priority) {
+  /* Counted before the task is published, as a worker may take it (and decrement the counter) right away */
+  PendingTasks.fetch_add(1);
+  if (Priority == TaskPriority::High) {
+    enqueue(HighTasks, std::move(T));
+  } else if (Priority == TaskPriority::Background) {
+    enqueue(BackgroundTasks, std::move(T));
+  } else if (CurrentPool == this && (Node == AnyNode || Node == ThreadNode || NodeTasks.empty())) {
+    Deques[CurrentIndex]->push(T.release());
+  } else if (Node != AnyNode && !NodeTasks.empty()) {
+    enqueue(*NodeTasks[Node % NodeTasks.size()], std::move(T));
+  } else {
+    enqueue(Tasks, std::move(T));
+  }
+
+  /* A spinning thread takes the task, or wakes up sleeping threads when it stops spinning */
+  if (!SpinningThreads.load() && SleepingThreads.load())
+    wake(1);
+}
+
+void ThreadPool::enqueue(TaskQueue &Queue, TaskPtr T) {
+  if (Queue.tryPush(std::move(T)))
+    return;
+
+  /* The task is executed out of order, but the worker (and therefore the whole pool) makes progress */
+  if (CurrentPool == this) {
+    Deques[CurrentIndex]->push(T.release());
+    return;
+  }
+
+  uint32_t Seed = Deques.size() + 1;
+  while (!Queue.tryPush(std::move(T))) {
+    if (TaskPtr Other = take(Deques.size(), Seed))
+      execute(std::move(Other));
+    else
+      std::this_thread::yield();
+  }
+}
+
+void ThreadPool::idle(unsigned &Rounds, const std::atomic_uint *Counter) {
+  if (Rounds < Idle.SpinRounds) {
+    if (!Rounds++)
+      SpinningThreads.fetch_add(1);
+
+    /* Exponential backoff, threads which spin for a longer time also yield to other threads */
+    unsigned Backoff = std::min(Idle.MaxBackoff, 1U << std::min(Rounds - 1, 16U));
+    for (unsigned N = 0; N < Backoff; ++N)
+      relaxCPU();
+    if (Backoff == Idle.MaxBackoff)
+      std::this_thread::yield();
+    return;
+  }
+
+  /*
+   * SleepingThreads is incremented (and SpinningThreads decremented) before PendingTasks is checked, while
+   * schedule increments PendingTasks before checking both counters. Either the thread sees the new task, or
+   * the submitting thread wakes it, or another spinning thread takes the task.
+   */
+  std::unique_lock<std::mutex> Lock(SleepMutex);
+  if (Rounds)
+    SpinningThreads.fetch_sub(1);
+  Rounds = 0;
+  SleepingThreads.fetch_add(1);
+  SleepCondition.wait(Lock, [&]() { return PendingTasks.load() || (Counter ? !Counter->load() : !Running); });
+
+  /*
+   * Woken threads spin again, so that they wake up further threads if more tasks are pending. Without
+   * spinning, schedule wakes up a thread for every task itself, as no thread is ever spinning.
+   */
+  if (Idle.SpinRounds) {
+    SpinningThreads.fetch_add(1);
+    Rounds = 1;
+  }
+  SleepingThreads.fetch_sub(1);
+}
+
+void ThreadPool::stopSpinning() {
+  if (SpinningThreads.fetch_sub(1) != 1)
+    return;
+
+  /* Tasks submitted while this thread was spinning did not wake up any thread */
+  std::size_t Pending = PendingTasks.load();
+  std::size_t Sleeping = SleepingThreads.load();
+  if (Pending && Sleeping)
+    wake(std::min(Pending, Sleeping));
+}
+
+void ThreadPool::wake(std::size_t Count) {
+  std::lock_guard<std::mutex> Lock(SleepMutex);
+  if (Count >= SleepingThreads.load()) {
+    SleepCondition.notify_all();
+    return;
+  }
+  for (std::size_t N = 0; N < Count; ++N)
+    SleepCondition.notify_one();
+}
+
+void ThreadPool::execute(TaskPtr T) {
+  Task::run(T.release());
+  if (--TotalTasks == 0) {
+    std::unique_lock<std::shared_mutex> Lock(Mutex);
+    Condition.notify_all();
+  }
+}
+
+void ThreadPool::doHelpUntilZero(const std::atomic_uint &Counter) {
+  unsigned Index = CurrentPool == this ? CurrentIndex : Deques.size();
+  uint32_t Seed = Index + 1;
+
+  unsigned Rounds = 0;
+  while (Counter.load()) {
+    if (TaskPtr T = take(Index, Seed)) {
+      if (Rounds)
+        stopSpinning();
+      Rounds = 0;
+      execute(std::move(T));
+      continue;
     }
+
+    /* The same protocol as for idle workers, except that the counter reaching zero also wakes the thread */
+    idle(Rounds, &Counter);
+  }
+
+  if (Rounds)
+    stopSpinning();
+}
+
+void ThreadPool::doNotifyHelpers() {
+  if (SleepingThreads.load()) {
+    std::lock_guard<std::mutex> Lock(SleepMutex);
+    SleepCondition.notify_all();
+  }
+}
+
+unsigned ThreadPool::doGetLoopSlots(std::size_t Count, std::size_t &Grain) const {
+  std::size_t ThreadNum = Threads.size() + 1;
+  if (!Grain)
+    Grain = std::max<std::size_t>(1, Count / (ThreadNum * ChunksPerThread));
+  std::size_t Chunks = (Count + Grain - 1) / Grain;
+  return std::max<std::size_t>(1, std::min(ThreadNum, Chunks));
+}
+
+void ThreadPool::doRunLoop(std::size_t Count, std::size_t Grain, unsigned Slots, ChunkFn Chunk, void *Context) {
+  std::size_t Chunks = (Count + Grain - 1) / Grain;
+  std::atomic_size_t Next = 0;
+  std::atomic_uint Pending = 0;
+
+  std::mutex ExceptionMutex;
+  std::exception_ptr Exception;
+
+  auto RunSlot = [&](unsigned Slot) {
+    try {
+      for (std::size_t N = Next.fetch_add(1); N < Chunks; N = Next.fetch_add(1))
+        Chunk(Context, Slot, N * Grain, std::min(Count, (N + 1) * Grain));
+    } catch (...) {
+      /* Skip the remaining chunks, the other slots finish their current chunk */
+      Next = Chunks;
+      std::lock_guard<std::mutex> Lock(ExceptionMutex);
+      if (!Exception)
+        Exception = std::current_exception();
+    }
+  };
+
+  for (unsigned Slot = 1; Slot < Slots; ++Slot) {
+    Pending.fetch_add(1);
+    doPost([this, &RunSlot, &Pending, Slot]() {
+      RunSlot(Slot);
+      if (Pending.fetch_sub(1) == 1)
+        doNotifyHelpers();
+    });
+  }
+
+  RunSlot(0);
+  doHelpUntilZero(Pending);
+
+  if (Exception)
+    std::rethrow_exception(Exception);
+}
+
+bool ThreadPool::doPinThreads(const std::vector<unsigned> &NewCPUs, const CPUTopology &Topology) {
+  if (NewCPUs.empty())
+    return false;
+
+  /* The current thread is the thread with ID 0, it keeps the affinity of the first CPU */
+  for (auto It = NewCPUs.rbegin(); It != NewCPUs.rend(); ++It)
+    if (!pinCurrentThread(*It))
+      return false;
+
+  CPUs = NewCPUs;
+  CPUNodes.clear();
+  NumNodes = 1;
+  for (unsigned CPU : CPUs) {
+    CPUNodes.push_back(Topology.getNode(CPU));
+    NumNodes = std::max(NumNodes, CPUNodes.back() + 1);
   }
+
+  ThreadNode = CPUNodes.front();
+  return true;
 }
 
 void ThreadPool::doInitialize(unsigned ThreadNum) {
   ThreadNum = std::max(1U, ThreadNum);
+  if (!Threads.empty()) {
+    doAwaitCompletion();
+    doShutdown();
+  }
 
-  /* Add current thread to map of thread IDs */
-  ThreadIDMap[std::this_thread::get_id()] = 0;
-
+  /* All deques have to exist before the first worker tries to steal from them */
   for (unsigned N = 1; N < ThreadNum; ++N) {
-    std::thread Thread(&ThreadPool::worker, this);
-    ThreadIDMap[Thread.get_id()] = N;
-    Threads.emplace_back(std::move(Thread));
+    Deques.push_back(std::make_unique<TaskDeque>());
+    WorkerNodes.push_back(CPUNodes.empty() ? 0 : CPUNodes[N % CPUNodes.size()]);
   }
-  Running = true;
-}
+  Statistics = std::make_unique<WorkerStatistics[]>(ThreadNum - 1);
+
+  /* Node queues are only needed if the workers (or the current thread) are on different nodes */
+  if (std::any_of(WorkerNodes.begin(), WorkerNodes.end(), [](unsigned Node) { return Node != ThreadNode; }))
+    for (unsigned N = 0; N < NumNodes; ++N)
+      NodeTasks.push_back(std::make_unique<TaskQueue>());
 
-unsigned ThreadPool::doGetThreadID() const {
-  return ThreadIDMap.empty() ? 0 : ThreadIDMap.at(std::this_thread::get_id());
+  /* Workers leave their loop immediately if they start before the pool is marked as running */
+  Running = true;
+  for (unsigned N = 1; N < ThreadNum; ++N)
+    Threads.emplace_back(&ThreadPool::worker, this, N - 1);
 }
 
 unsigned ThreadPool::doGetThreadNum() const {
   return Threads.size();
 }
 
+void ThreadPool::doSetIdleOptions(const IdleOptions &Options) {
+  assert(Threads.empty() && "Idle options have to be set before the workers are started");
+  Idle = Options;
+}
+
+std::vector<ThreadPool::NodeStatistics> ThreadPool::doGetNodeStatistics() const {
+  std::vector<NodeStatistics> Result(NumNodes);
+  for (unsigned Index = 0; Index < WorkerNodes.size(); ++Index) {
+    NodeStatistics &Node = Result[WorkerNodes[Index]];
+    Node.Workers++;
+    Node.LocalTasks += Statistics[Index].Local.load(std::memory_order_relaxed);
+    Node.RemoteTasks += Statistics[Index].Remote.load(std::memory_order_relaxed);
+  }
+  return Result;
+}
+
 void ThreadPool::doAwaitCompletion() {
   std::unique_lock<std::shared_mutex> Lock(Mutex);
   Condition.wait(Lock, [&]() { return TotalTasks == 0; });
 }
 
 void ThreadPool::doShutdown() {
-  Running = false;
-  Tasks.invalidate();
+  {
+    std::lock_guard<std::mutex> Lock(SleepMutex);
+    Running = false;
+    SleepCondition.notify_all();
+  }
   for (auto &Thread : Threads) {
     if (Thread.joinable())
       Thread.join();
   }
+
+  /* Discard all tasks which have not been started, the deques own their tasks */
+  Task *Raw = nullptr;
+  for (std::unique_ptr<TaskDeque> &Deque : Deques)
+    while (Deque->pop(Raw))
+      Task::discard(Raw);
+  for (TaskQueue *Queue : {&HighTasks, &Tasks, &BackgroundTasks})
+    for (TaskPtr Discarded; Queue->tryPop(Discarded);)
+      Discarded.reset();
+  for (std::unique_ptr<TaskQueue> &Queue : NodeTasks)
+    for (TaskPtr Discarded; Queue->tryPop(Discarded);)
+      Discarded.reset();
+
+  Deques.clear();
+  NodeTasks.clear();
+  WorkerNodes.clear();
+  Statistics.reset();
+  Threads.clear();
+  PendingTasks = 0;
+  TotalTasks = 0;
 }
 
 /*
  * Static public methods
  */
 
-void ThreadPool::initialize(unsigned Threads) {
-  get().doInitialize(Threads);
+bool ThreadPool::pinThreads(const std::vector<unsigned> &CPUs, const CPUTopology &Topology) {
+  return getDefault().doPinThreads(CPUs, Topology);
 }
 
-unsigned ThreadPool::getThreadID() {
-  return get().doGetThreadID();
+void ThreadPool::initialize(unsigned Threads) {
+  getDefault().doInitialize(Threads);
 }
 
 unsigned ThreadPool::getThreadNum() {
-  return get().doGetThreadNum();
+  return getDefault().doGetThreadNum();
+}
+
+unsigned ThreadPool::getNumNodes() {
+  return getDefault().NumNodes;
+}
+
+std::vector<ThreadPool::NodeStatistics> ThreadPool::getNodeStatistics() {
+  return getDefault().doGetNodeStatistics();
+}
+
+void ThreadPool::setIdleOptions(const IdleOptions &Options) {
+  getDefault().doSetIdleOptions(Options);
+}
+
+unsigned ThreadPool::getSpinningThreads() {
+  return getDefault().SpinningThreads.load();
+}
+
+unsigned ThreadPool::getSleepingThreads() {
+  return getDefault().SleepingThreads.load();
 }
 
 void ThreadPool::awaitCompletion() {
-  get().doAwaitCompletion();
+  getDefault().doAwaitCompletion();
 }
 
 void ThreadPool::shutdown() {
-  get().doShutdown();
+  getDefault().doShutdown();
 }
 
 } // namespace icarus
@@ -0,0 +1,93 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include "icarus/Threads/Topology.h"
+
+#include <fstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace icarus {
+
+std::optional<std::vector<unsigned>> parseCPUList(llvm::StringRef List) {
+  std::vector<unsigned> CPUs;
+  llvm::SmallVector<llvm::StringRef, 8> Entries;
+  List.trim().split(Entries, ',');
+
+  for (llvm::StringRef Entry : Entries) {
+    auto [FirstStr, LastStr] = Entry.trim().split('-');
+    unsigned First, Last;
+    if (FirstStr.getAsInteger(10, First))
+      return std::nullopt;
+    if (LastStr.empty())
+      Last = First;
+    else if (LastStr.getAsInteger(10, Last) || Last < First)
+      return std::nullopt;
+
+    for (unsigned CPU = First; CPU <= Last; ++CPU)
+      CPUs.push_back(CPU);
+  }
+
+  return CPUs;
+}
+
+/*
+ * CPUTopology methods
+ */
+
+CPUTopology::CPUTopology(llvm::StringRef NodePath) {
+  std::error_code EC;
+  for (llvm::sys::fs::directory_iterator It(NodePath, EC), End; It != End && !EC; It.increment(EC)) {
+    llvm::StringRef Name = llvm::sys::path::filename(It->path());
+    unsigned Node;
+    if (!Name.consume_front("node") || Name.getAsInteger(10, Node))
+      continue;
+
+    llvm::SmallString<64> ListPath(It->path());
+    llvm::sys::path::append(ListPath, "cpulist");
+    std::ifstream ListFile(ListPath.str().str());
+    std::string List;
+    std::getline(ListFile, List);
+
+    /* Nodes without CPUs (e.g. memory-only nodes) have an empty list */
+    std::optional<std::vector<unsigned>> CPUs = parseCPUList(List);
+    if (!CPUs)
+      continue;
+
+    NumNodes = std::max(NumNodes, Node + 1);
+    for (unsigned CPU : *CPUs) {
+      if (CPU >= CPUNodes.size())
+        CPUNodes.resize(CPU + 1, 0);
+      CPUNodes[CPU] = Node;
+    }
+  }
+}
+
+unsigned CPUTopology::getNode(unsigned CPU) const {
+  return CPU < CPUNodes.size() ? CPUNodes[CPU] : 0;
+}
+
+bool pinCurrentThread(unsigned CPU) {
+#ifdef __linux__
+  if (CPU >= CPU_SETSIZE)
+    return false;
+
+  cpu_set_t Set;
+  CPU_ZERO(&Set);
+  CPU_SET(CPU, &Set);
+  return !pthread_setaffinity_np(pthread_self(), sizeof(Set), &Set);
+#else
+  return false;
+#endif
+}
+
+} // namespace icarus
@@ -0,0 +1,117 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/ADT/PersistentMap.h>
+
+#include <map>
+#include <string>
+
+using namespace icarus::adt;
+
+/**
+ * Hash function which maps all keys to the same hash, forcing the trie to use its collision nodes.
+ */
+struct CollidingHash {
+  std::size_t operator()(int) const {
+    return 42;
+  }
+};
+
+TEST_CASE("Testing PersistentMap insertion and lookup") {
+  PersistentMap<int, std::string> Map;
+
+  CHECK(Map.empty());
+  CHECK(Map.lookup(1) == nullptr);
+
+  for (int N = 0; N < 1000; ++N)
+    Map.insert(N, std::to_string(N));
+
+  CHECK(Map.size() == 1000);
+  for (int N = 0; N < 1000; ++N) {
+    REQUIRE(Map.lookup(N) != nullptr);
+    CHECK(*Map.lookup(N) == std::to_string(N));
+  }
+  CHECK(Map.lookup(1000) == nullptr);
+
+  SUBCASE("Testing replacing values") {
+    Map.insert(7, "seven");
+    CHECK(Map.size() == 1000);
+    CHECK(*Map.lookup(7) == "seven");
+  }
+
+  SUBCASE("Testing erasing values") {
+    for (int N = 0; N < 1000; N += 2)
+      CHECK(Map.erase(N));
+    CHECK(!Map.erase(0));
+    CHECK(Map.size() == 500);
+    for (int N = 0; N < 1000; ++N)
+      CHECK(Map.contains(N) == (N % 2 == 1));
+  }
+
+  SUBCASE("Testing iteration over all values") {
+    std::map<int, std::string> Entries;
+    Map.forEach([&](int Key, const std::string &Value) { Entries[Key] = Value; });
+    CHECK(Entries.size() == 1000);
+    CHECK(Entries[999] == "999");
+  }
+}
+
+TEST_CASE("Testing PersistentMap copy-on-write semantics") {
+  PersistentMap<int, std::string> Parent;
+  for (int N = 0; N < 100; ++N)
+    Parent.insert(N, std::to_string(N));
+
+  PersistentMap<int, std::string> Child = Parent;
+  CHECK(Child.sharesRootWith(Parent));
+
+  SUBCASE("Testing modifications in the copy") {
+    *Child.lookupMutable(5) = "five";
+    Child.insert(100, "100");
+    Child.erase(6);
+
+    CHECK(!Child.sharesRootWith(Parent));
+    CHECK(*Parent.lookup(5) == "5");
+    CHECK(*Child.lookup(5) == "five");
+    CHECK(Parent.size() == 100);
+    CHECK(Child.size() == 100);
+    CHECK(!Parent.contains(100));
+    CHECK(Parent.contains(6));
+    CHECK(!Child.contains(6));
+
+    /* Values that were not modified are still shared */
+    CHECK(Parent.lookup(42) == Child.lookup(42));
+  }
+
+  SUBCASE("Testing modifications in the original") {
+    Parent.getOrInsert(5) = "five";
+    CHECK(*Parent.lookup(5) == "five");
+    CHECK(*Child.lookup(5) == "5");
+  }
+
+  SUBCASE("Testing in-place modification of unshared maps") {
+    Child = PersistentMap<int, std::string>();
+    const std::string *Before = Parent.lookup(5);
+    *Parent.lookupMutable(5) = "five";
+    CHECK(Parent.lookup(5) == Before);
+  }
+}
+
+TEST_CASE("Testing PersistentMap with colliding hashes") {
+  PersistentMap<int, int, CollidingHash> Map;
+  for (int N = 0; N < 10; ++N)
+    Map.insert(N, N * N);
+
+  PersistentMap<int, int, CollidingHash> Copy = Map;
+  Copy.erase(3);
+  Copy.getOrInsert(4) = 0;
+
+  CHECK(Map.size() == 10);
+  CHECK(Copy.size() == 9);
+  for (int N = 0; N < 10; ++N)
+    CHECK(*Map.lookup(N) == N * N);
+  CHECK(!Copy.contains(3));
+  CHECK(*Copy.lookup(4) == 0);
+}
@@ -0,0 +1,119 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Analysis/Liveness.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace icarus;
+
+static const char *LivenessModule = R"(
+define i32 @loop(i32 %n, i32 %m) {
+entry:
+  br label %header
+header:
+  %i = phi i32 [ 0, %entry ], [ %next, %body ]
+  %cmp = icmp slt i32 %i, %n
+  br i1 %cmp, label %body, label %check
+body:
+  %next = add i32 %i, 1
+  br label %header
+check:
+  %neg = icmp slt i32 %m, 0
+  br i1 %neg, label %fail, label %exit
+fail:
+  unreachable
+exit:
+  ret i32 %i
+}
+
+define i32 @single(i32 %a) {
+entry:
+  ret i32 %a
+}
+
+declare void @external()
+)";
+
+static llvm::BasicBlock *getBlock(llvm::Function &F, llvm::StringRef Name) {
+  for (llvm::BasicBlock &BB : F)
+    if (BB.getName() == Name)
+      return &BB;
+  return nullptr;
+}
+
+static llvm::Value *getValue(llvm::Function &F, llvm::StringRef Name) {
+  for (llvm::Argument &A : F.args())
+    if (A.getName() == Name)
+      return &A;
+  for (llvm::BasicBlock &BB : F)
+    for (llvm::Instruction &I : BB)
+      if (I.getName() == Name)
+        return &I;
+  return nullptr;
+}
+
+TEST_CASE("Testing backward dataflow liveness") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(LivenessModule, Err, Context);
+  REQUIRE(M);
+
+  llvm::Function &F = *M->getFunction("loop");
+  LivenessAnalysis Liveness(F);
+  BackwardDataflow<LivenessAnalysis> Dataflow(Liveness, F);
+  CHECK(Dataflow.solve() >= 6);
+
+  auto IsLiveIn = [&](llvm::StringRef Block, llvm::StringRef Value) {
+    return Liveness.isLive(Dataflow.getIn(*getBlock(F, Block)), getValue(F, Value));
+  };
+  auto IsLiveOut = [&](llvm::StringRef Block, llvm::StringRef Value) {
+    return Liveness.isLive(Dataflow.getOut(*getBlock(F, Block)), getValue(F, Value));
+  };
+
+  /* Arguments are live until their last use in any of the exits */
+  CHECK(IsLiveIn("entry", "n"));
+  CHECK(IsLiveIn("entry", "m"));
+  CHECK(IsLiveIn("body", "m"));
+  CHECK(!IsLiveIn("exit", "m"));
+
+  /* Values used by PHI nodes are only live at the end of the incoming block */
+  CHECK(IsLiveOut("body", "next"));
+  CHECK(!IsLiveIn("header", "next"));
+  CHECK(IsLiveIn("body", "i"));
+  CHECK(IsLiveIn("check", "i"));
+  CHECK(IsLiveIn("exit", "i"));
+
+  /* Multiple exit blocks */
+  CHECK(!IsLiveIn("fail", "i"));
+  CHECK(Dataflow.getOut(*getBlock(F, "fail")).none());
+  CHECK(!IsLiveOut("exit", "i"));
+}
+
+TEST_CASE("Testing backward dataflow on all functions of a module") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(LivenessModule, Err, Context);
+  REQUIRE(M);
+
+  std::mutex Mutex;
+  std::vector<std::string> Solved;
+  solveBackwardDataflow(
+      *M, [](llvm::Function &F) { return LivenessAnalysis(F); },
+      [&](llvm::Function &F, LivenessAnalysis &Liveness, const BackwardDataflow<LivenessAnalysis> &Dataflow) {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Solved.push_back(F.getName().str());
+        CHECK(Liveness.isLive(Dataflow.getIn(F.getEntryBlock()), &*F.arg_begin()));
+      });
+
+  std::sort(Solved.begin(), Solved.end());
+  CHECK(Solved == std::vector<std::string>{"loop", "single"});
+}
@@ -0,0 +1,111 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Analysis/CallGraph.h>
+
+using namespace icarus;
+
+static const char *CallerModule = R"(
+declare void @leaf()
+
+define void @main() {
+  call void @even()
+  call void @leaf()
+  call void bitcast (void ()* @helper to void (i32)*)(i32 0)
+  ret void
+}
+
+define void @even() {
+  call void @odd()
+  ret void
+}
+
+define void @odd() {
+  call void @even()
+  call void @leaf()
+  ret void
+}
+
+define internal void @helper() {
+  ret void
+}
+)";
+
+static const char *CalleeModule = R"(
+define void @leaf() {
+  call void @recursive()
+  ret void
+}
+
+define void @recursive() {
+  call void @recursive()
+  ret void
+}
+
+define internal void @helper() {
+  ret void
+}
+)";
+
+TEST_CASE("Testing call graph SCCs across modules") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> Caller = llvm::parseAssemblyString(CallerModule, Err, Context);
+  std::unique_ptr<llvm::Module> Callee = llvm::parseAssemblyString(CalleeModule, Err, Context);
+  REQUIRE(Caller);
+  REQUIRE(Callee);
+
+  CallGraphSCCs SCCs({Caller.get(), Callee.get()});
+  CHECK(SCCs.size() == 6);
+
+  auto GetSCC = [&](llvm::Module &M, llvm::StringRef Name) { return SCCs.getSCC(M.getFunction(Name)); };
+
+  /* Declarations are resolved to the definition in the other module, internal functions are not */
+  const CallGraphSCCs::SCC *Leaf = GetSCC(*Caller, "leaf");
+  REQUIRE(Leaf);
+  CHECK(Leaf == GetSCC(*Callee, "leaf"));
+  CHECK(GetSCC(*Caller, "helper") != GetSCC(*Callee, "helper"));
+
+  /* Mutually recursive functions share an SCC */
+  const CallGraphSCCs::SCC *Even = GetSCC(*Caller, "even");
+  CHECK(Even == GetSCC(*Caller, "odd"));
+  CHECK(Even->Functions.size() == 2);
+  CHECK(Even->Recursive);
+  CHECK(GetSCC(*Callee, "recursive")->Recursive);
+  CHECK(!Leaf->Recursive);
+
+  const CallGraphSCCs::SCC *Main = GetSCC(*Caller, "main");
+  CHECK(Main->Callees.size() == 3);
+  CHECK(Main->Callers.empty());
+  CHECK(Leaf->Callers.size() == 2);
+
+  /* The longest chain of calls is main -> even/odd -> leaf -> recursive */
+  CHECK(Main->Critical);
+  CHECK(Even->Critical);
+  CHECK(Leaf->Critical);
+  CHECK(GetSCC(*Callee, "recursive")->Critical);
+  CHECK(!GetSCC(*Caller, "helper")->Critical);
+  CHECK(!GetSCC(*Callee, "helper")->Critical);
+
+  /* SCCs are numbered bottom-up */
+  for (const CallGraphSCCs::SCC &C : SCCs)
+    for (unsigned Callee : C.Callees)
+      CHECK(Callee < C.Index);
+
+  SUBCASE("Testing bottom-up traversal") {
+    std::vector<bool> Done(SCCs.size());
+    SCCs.runBottomUp([&](const CallGraphSCCs::SCC &C) {
+      for (unsigned Callee : C.Callees)
+        CHECK(Done[Callee]);
+      Done[C.Index] = true;
+    });
+    CHECK(std::all_of(Done.begin(), Done.end(), [](bool D) { return D; }));
+  }
+}
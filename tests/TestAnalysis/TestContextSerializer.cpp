@@ -0,0 +1,166 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Analysis/Checkpoint.h>
+#include <icarus/Passes/AIAPass.h>
+
+using namespace icarus;
+
+static const char *SerializerModule = R"(
+@counter = global i32 0
+@pointer = global i32* null
+
+define i32 @inc(i32 %a) {
+entry:
+  %b = add i32 %a, 42
+  ret i32 %b
+}
+
+define i32 @main() {
+entry:
+  %c = call i32 @inc(i32 1)
+  ret i32 %c
+}
+)";
+
+TEST_CASE("Testing ContextSerializer") {
+  using Context = ProgramContext<passes::DefaultAnalysisIterator>;
+
+  llvm::LLVMContext LLVMContext;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(SerializerModule, Err, LLVMContext);
+  REQUIRE(M);
+
+  llvm::GlobalVariable *Counter = M->getNamedGlobal("counter");
+  llvm::GlobalVariable *Pointer = M->getNamedGlobal("pointer");
+  llvm::Function *Main = M->getFunction("main");
+  llvm::Function *Inc = M->getFunction("inc");
+  auto *Call = llvm::cast<llvm::CallInst>(&Main->getEntryBlock().front());
+  llvm::Instruction *Add = &Inc->getEntryBlock().front();
+  llvm::Value *FortyTwo = Add->getOperand(1);
+
+  ModuleIndex Index(M.get());
+
+  Context PC;
+  PC.allocateGlobalValues(*M);
+  PC.getMutableEngineValue(Counter)->store(0, 4, FortyTwo);
+  PC.getMutableEngineValue(Pointer)->store(0, 8, ValueDelegate(PC.getMutableEngineValue(Counter), 0));
+  PC.setAddressableValue(0x1000, Counter);
+
+  PC.pushFunctionContext(*Main);
+  PC.getCurrentFunctionStack().nextInstruction();
+  auto &Frame = PC.pushFunctionContext(*Inc, Call);
+  Frame.setValue(Add, FortyTwo);
+  Frame.nextInstruction();
+
+  ContextWriter Writer(Index);
+  Writer.writeProgramContext(PC);
+  std::string State = Writer.takeBuffer();
+
+  SUBCASE("Testing encoding of values") {
+    for (llvm::Value *V : {static_cast<llvm::Value *>(Counter), static_cast<llvm::Value *>(Inc), FortyTwo,
+                           static_cast<llvm::Value *>(Add), static_cast<llvm::Value *>(&Inc->getEntryBlock())}) {
+      std::vector<uint64_t> Indices;
+      REQUIRE(Index.encode(V, Indices));
+      llvm::ArrayRef<uint64_t> Encoded(Indices);
+      llvm::Value *Decoded;
+      CHECK(Index.decode(Encoded, Decoded));
+      CHECK(Decoded == V);
+      CHECK(Encoded.empty());
+    }
+  }
+
+  SUBCASE("Testing round trip of program contexts") {
+    Context Restored;
+    ContextReader Reader(Index, State);
+    REQUIRE(Reader.readProgramContext(Restored));
+    CHECK(Reader.atEnd());
+
+    CHECK(Restored.getNamedValue("counter") == Counter);
+    CHECK(Restored.getAddressableValue(0x1000) == Counter);
+    CHECK(Restored.getNumEngineValues() == 2);
+    CHECK(Restored.getEngineValue(Counter)->load(0, 4) == ValueDelegate(FortyTwo));
+
+    ValueDelegate Target = Restored.getEngineValue(Pointer)->load(0, 8);
+    REQUIRE(Target.isNodeDelegate());
+    CHECK(Target.getBase() == Counter);
+    CHECK(Restored.getDelegate(Target) == ValueDelegate(FortyTwo));
+
+    REQUIRE(Restored.getStackDepth() == 2);
+    auto &Restored1 = Restored.getCurrentFunctionStack();
+    CHECK(Restored1.getFunction() == Inc);
+    CHECK(Restored1.getCaller() == Call);
+    CHECK(Restored1.getPosition() == 1);
+    CHECK(Restored1.getValue(Add) == ValueDelegate(FortyTwo));
+    CHECK(Restored1.nextInstruction() == Inc->getEntryBlock().getTerminator());
+  }
+
+  SUBCASE("Testing truncated states") {
+    Context Restored;
+    ContextReader Reader(Index, llvm::StringRef(State).drop_back(3));
+    CHECK(!Reader.readProgramContext(Restored));
+    CHECK(Reader.hasFailed());
+  }
+
+  SUBCASE("Testing states which cannot be restored") {
+    CHECK(!Writer.hasFailed());
+
+    /* The pointer still refers to the freed region */
+    Context Freed = PC.fork();
+    Freed.freeEngineValue(Counter);
+    ContextWriter FreedWriter(Index);
+    FreedWriter.writeProgramContext(Freed);
+    CHECK(FreedWriter.hasFailed());
+
+    /* Constants which are not used by any instruction cannot be encoded */
+    Context Unencodable = PC.fork();
+    Unencodable.allocateEngineValue(llvm::ConstantInt::get(llvm::Type::getInt64Ty(LLVMContext), 12345), 8);
+    ContextWriter UnencodableWriter(Index);
+    UnencodableWriter.writeProgramContext(Unencodable);
+    CHECK(UnencodableWriter.hasFailed());
+
+    /* The last checkpoint is kept if a context cannot be written */
+    llvm::SmallString<128> Path;
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "ckpt", Path));
+    Checkpointer Checkpoints(Index, Path, std::chrono::seconds(0));
+    REQUIRE(Checkpoints.save(std::vector<Context>{PC.fork()}));
+    CHECK(!Checkpoints.save(std::vector<Context>{PC.fork(), std::move(Freed)}));
+
+    std::vector<Context> Contexts;
+    REQUIRE(Checkpoints.restore(Contexts));
+    CHECK(Contexts.size() == 1);
+    llvm::sys::fs::remove(Path);
+  }
+
+  SUBCASE("Testing checkpoint files") {
+    llvm::SmallString<128> Path;
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "ckpt", Path));
+
+    Checkpointer Checkpoints(Index, Path, std::chrono::seconds(0));
+    CHECK(Checkpoints.isDue());
+    REQUIRE(Checkpoints.save(std::vector<Context>{PC.fork(), PC.fork()}));
+
+    std::vector<Context> Contexts;
+    REQUIRE(Checkpoints.restore(Contexts));
+    REQUIRE(Contexts.size() == 2);
+    CHECK(Contexts[1].getStackDepth() == 2);
+
+    /* Checkpoints of different modules are rejected */
+    std::unique_ptr<llvm::Module> Other = llvm::parseAssemblyString("@x = global i32 0", Err, LLVMContext);
+    ModuleIndex OtherIndex(Other.get());
+    std::vector<std::string> States;
+    CHECK(!Checkpointer(OtherIndex, Path, std::chrono::seconds(0)).read(States));
+
+    llvm::sys::fs::remove(Path);
+  }
+}
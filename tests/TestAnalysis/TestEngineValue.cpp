@@ -0,0 +1,153 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+
+#include <icarus/Analysis/EngineValue.h>
+
+#include <cstring>
+#include <memory>
+
+using namespace icarus;
+
+TEST_CASE("Testing ValueDelegate encodings") {
+  llvm::LLVMContext Context;
+  llvm::Value *CVal = llvm::ConstantInt::get(llvm::Type::getInt32Ty(Context), 42);
+  llvm::Value *Base = llvm::ConstantInt::get(llvm::Type::getInt64Ty(Context), 0);
+  EngineValue Node(Base, 64);
+
+  SUBCASE("Testing invalid delegates") {
+    ValueDelegate D;
+    CHECK(!D.isValid());
+    CHECK(!D.isNodeDelegate());
+    CHECK(D.getIdentity() == nullptr);
+    CHECK(!ValueDelegate(static_cast<llvm::Value *>(nullptr)).isValid());
+  }
+
+  SUBCASE("Testing delegates for llvm::Value instances") {
+    ValueDelegate D(CVal);
+    CHECK(D.isValid());
+    CHECK(!D.isNodeDelegate());
+    CHECK(D.getValue() == CVal);
+    CHECK(D.getOffset() == 0);
+  }
+
+  SUBCASE("Testing delegates with inline offsets") {
+    ValueDelegate D(&Node, 24);
+    CHECK(D.isValid());
+    CHECK(D.isNodeDelegate());
+    CHECK(D.getBase() == Base);
+    CHECK(D.getOffset() == 24);
+    CHECK(D != ValueDelegate(&Node, 16));
+  }
+
+  SUBCASE("Testing delegates with out-of-line offsets") {
+    uint64_t Offset = uint64_t(1) << 40;
+    ValueDelegate D(&Node, Offset);
+    CHECK(D.isNodeDelegate());
+    CHECK(D.getBase() == Base);
+    CHECK(D.getOffset() == Offset);
+    CHECK(D == ValueDelegate(&Node, Offset));
+    CHECK(hash_value(D) == hash_value(ValueDelegate(&Node, Offset)));
+    CHECK(D != ValueDelegate(&Node, Offset + 1));
+  }
+
+  SUBCASE("Testing out-of-line offsets into copies of a node") {
+    /* Copies of a node share the interned record, so both delegates have the same encoding */
+    uint64_t Offset = uint64_t(1) << 40;
+    ValueDelegate D(&Node, Offset);
+    auto Copy = std::make_unique<EngineValue>(Node);
+    ValueDelegate E(Copy.get(), Offset);
+    Copy.reset();
+    CHECK(std::memcmp(&D, &E, sizeof(ValueDelegate)) == 0);
+    CHECK(E.getBase() == Base);
+    CHECK(E.getOffset() == Offset);
+  }
+}
+
+TEST_CASE("Testing EngineValue memory model") {
+  llvm::LLVMContext Context;
+  llvm::Value *A = llvm::ConstantInt::get(llvm::Type::getInt32Ty(Context), 1);
+  llvm::Value *B = llvm::ConstantInt::get(llvm::Type::getInt32Ty(Context), 2);
+  EngineValue Region(nullptr, 64);
+
+  Region.store(0, 8, A);
+  Region.store(8, 4, B);
+  CHECK(Region.getNumFragments() == 2);
+
+  SUBCASE("Testing loads of exact ranges") {
+    CHECK(Region.load(0, 8) == ValueDelegate(A));
+    CHECK(Region.load(8, 4) == ValueDelegate(B));
+    CHECK(!Region.load(0, 4).isValid());
+    CHECK(!Region.load(4, 4).isValid());
+    CHECK(!Region.load(16, 4).isValid());
+  }
+
+  SUBCASE("Testing partially overlapping stores") {
+    Region.store(4, 8, B);
+    CHECK(Region.getNumFragments() == 2);
+    CHECK(!Region.load(0, 4).isValid());
+    CHECK(Region.load(4, 8) == ValueDelegate(B));
+    CHECK(!Region.getDelegate(0).isValid());
+  }
+
+  SUBCASE("Testing merges of unknown bytes") {
+    /* Partially overwritten values become unknown, together with the overwritten bytes */
+    Region.store(2, 1, ValueDelegate());
+    CHECK(Region.getNumFragments() == 2);
+    CHECK(Region.load(8, 4) == ValueDelegate(B));
+
+    Region.store(8, 2, ValueDelegate());
+    CHECK(Region.getNumFragments() == 1);
+    CHECK(!Region.load(0, 12).isValid());
+
+    Region.store(4, 4, A);
+    CHECK(Region.getNumFragments() == 3);
+    CHECK(Region.load(4, 4) == ValueDelegate(A));
+  }
+
+  SUBCASE("Testing DataLayout-aware accesses") {
+    llvm::DataLayout DL("e-i64:64");
+    Region.store(DL, 16, llvm::Type::getInt64Ty(Context), A);
+    CHECK(Region.load(16, 8) == ValueDelegate(A));
+    CHECK(Region.load(DL, 8, llvm::Type::getInt32Ty(Context)) == ValueDelegate(B));
+    CHECK(!Region.load(DL, 16, llvm::Type::getInt32Ty(Context)).isValid());
+  }
+
+  SUBCASE("Testing accesses beyond the region") {
+    CHECK(!Region.store(60, 8, A));
+    CHECK(!Region.store(64, 1, A));
+    CHECK(!Region.store(~uint64_t(0), 2, A));
+    CHECK(Region.store(56, 8, A));
+    CHECK(Region.getNumFragments() == 3);
+
+    EngineValue Other(nullptr, 8);
+    CHECK(!Other.copyRange(0, Region, 0, 12));
+    CHECK(!Region.copyRange(60, Other, 0, 8));
+    CHECK(Other.getNumFragments() == 0);
+  }
+
+  SUBCASE("Testing copies between regions") {
+    EngineValue Other(nullptr, 64);
+    Other.copyRange(32, Region, 0, 12);
+    CHECK(Other.load(32, 8) == ValueDelegate(A));
+    CHECK(Other.load(40, 4) == ValueDelegate(B));
+
+    Other.copyRange(0, Region, 4, 8);
+    CHECK(Other.getNumFragments() == 4);
+    CHECK(!Other.load(0, 4).isValid());
+    CHECK(Other.load(4, 4) == ValueDelegate(B));
+  }
+
+  SUBCASE("Testing overlapping copies within a region") {
+    Region.copyRange(4, Region, 0, 12);
+    CHECK(Region.load(4, 8) == ValueDelegate(A));
+    CHECK(Region.load(12, 4) == ValueDelegate(B));
+    CHECK(!Region.load(0, 4).isValid());
+    CHECK(Region.getNumFragments() == 3);
+  }
+}
@@ -0,0 +1,62 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+
+#include <icarus/Analysis/FramePool.h>
+
+#include <thread>
+
+using namespace icarus;
+
+TEST_CASE("Testing FramePool storage reuse") {
+  FramePool &Pool = FramePool::get();
+  llvm::LLVMContext Context;
+  EngineValue Node(llvm::ConstantInt::get(llvm::Type::getInt64Ty(Context), 0), 64);
+
+  const ValueDelegate *Data;
+  {
+    FrameStorage Storage(10);
+    CHECK(Storage.size() == 10);
+    CHECK(Storage.capacity() == 16);
+    Storage[3] = ValueDelegate(&Node);
+    Data = &Storage[0];
+  }
+
+  std::size_t Reused = Pool.getNumReused();
+
+  SUBCASE("Testing reuse for frames of the same capacity") {
+    FrameStorage Storage(12);
+    CHECK(&Storage[0] == Data);
+    CHECK(Pool.getNumReused() == Reused + 1);
+
+    /* Reused storages must not contain values of previous call frames */
+    CHECK(!Storage[3].isValid());
+  }
+
+  SUBCASE("Testing frames of a different capacity") {
+    FrameStorage Storage(100);
+    CHECK(Storage.capacity() == 128);
+    CHECK(Pool.getNumReused() == Reused);
+  }
+
+  SUBCASE("Testing copies of frames") {
+    FrameStorage Storage(4);
+    Storage[1] = ValueDelegate(&Node, 8);
+
+    FrameStorage Copy = Storage;
+    CHECK(&Copy[0] != &Storage[0]);
+    CHECK(Copy[1] == Storage[1]);
+  }
+
+  SUBCASE("Testing frames released in another thread") {
+    FrameStorage Storage(6);
+    std::thread Thread([Moved = std::move(Storage)]() mutable { FrameStorage Local = std::move(Moved); });
+    Thread.join();
+    CHECK(Storage.size() == 0);
+  }
+}
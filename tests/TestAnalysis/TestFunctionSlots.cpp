@@ -0,0 +1,61 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Analysis/FunctionSlots.h>
+
+using namespace icarus;
+
+static const char *SlotsModule = R"(
+define i32 @add(i32 %a, i32 %b) {
+entry:
+  %sum = add i32 %a, %b
+  br label %exit
+exit:
+  %res = mul i32 %sum, 2
+  ret i32 %res
+}
+)";
+
+TEST_CASE("Testing FunctionSlots numbering") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(SlotsModule, Err, Context);
+  REQUIRE(M);
+
+  llvm::Function *F = M->getFunction("add");
+  const FunctionSlots &Slots = FunctionSlots::get(*F);
+
+  /* Two arguments, four instructions */
+  CHECK(Slots.getNumSlots() == 6);
+  CHECK(&Slots == &FunctionSlots::get(*F));
+
+  for (unsigned Slot = 0; Slot < Slots.getNumSlots(); ++Slot)
+    CHECK(Slots.getSlot(Slots.getValue(Slot)) == static_cast<int>(Slot));
+
+  CHECK(Slots.getSlot(&*F->arg_begin()) == 0);
+  CHECK(Slots.getSlot(&*std::next(F->arg_begin())) == 1);
+  CHECK(Slots.getSlot(F) == -1);
+
+  SUBCASE("Testing operand slots") {
+    llvm::Instruction &Sum = F->getEntryBlock().front();
+    llvm::ArrayRef<int> SumOperands = Slots.getOperandSlots(Sum);
+    REQUIRE(SumOperands.size() == 2);
+    CHECK(SumOperands[0] == 0);
+    CHECK(SumOperands[1] == 1);
+
+    llvm::Instruction &Res = F->back().front();
+    llvm::ArrayRef<int> ResOperands = Slots.getOperandSlots(Res);
+    REQUIRE(ResOperands.size() == 2);
+    CHECK(ResOperands[0] == Slots.getSlot(&Sum));
+    CHECK(ResOperands[1] == -1);
+    CHECK(Slots.getOperandSlots(static_cast<unsigned>(Slots.getSlot(&Res))) == ResOperands);
+  }
+}
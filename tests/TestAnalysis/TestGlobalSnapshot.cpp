@@ -0,0 +1,107 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Analysis/ProgramContext.h>
+#include <icarus/Passes/AIAPass.h>
+
+#include <thread>
+#include <vector>
+
+using namespace icarus;
+
+static const char *GlobalsModule = R"(
+@counter = global i32 0
+@table = global [4 x i64] zeroinitializer
+@external = external global i32
+)";
+
+TEST_CASE("Testing GlobalSnapshot") {
+  using Context = ProgramContext<passes::DefaultAnalysisIterator>;
+
+  llvm::LLVMContext LLVMContext;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(GlobalsModule, Err, LLVMContext);
+  REQUIRE(M);
+
+  llvm::GlobalVariable *Counter = M->getNamedGlobal("counter");
+  llvm::GlobalVariable *Table = M->getNamedGlobal("table");
+  llvm::Value *Init = llvm::ConstantInt::get(llvm::Type::getInt32Ty(LLVMContext), 7);
+
+  Context PC;
+  PC.allocateGlobalValues(*M);
+  PC.getMutableEngineValue(Counter)->store(0, 4, Init);
+  std::shared_ptr<const GlobalSnapshot> Snapshot = PC.takeSnapshot();
+
+  CHECK(Snapshot->getNumEngineValues() == 2);
+  CHECK(Snapshot->getNamedValue("table") == Table);
+  CHECK(Snapshot->getNamedValue("external") == nullptr);
+  CHECK(Snapshot->getEngineValue(Table)->getSize() == 32);
+
+  SUBCASE("Testing contexts created from a snapshot") {
+    Context First(*Snapshot), Second(*Snapshot);
+    CHECK(First.getEngineValue(Counter) == Snapshot->getEngineValue(Counter));
+
+    First.getMutableEngineValue(Counter)->store(0, 4, ValueDelegate());
+    CHECK(!First.getEngineValue(Counter)->load(0, 4).isValid());
+    CHECK(Second.getEngineValue(Counter)->load(0, 4) == ValueDelegate(Init));
+    CHECK(Snapshot->getEngineValue(Counter)->load(0, 4) == ValueDelegate(Init));
+    CHECK(Second.getEngineValue(Table) == Snapshot->getEngineValue(Table));
+  }
+
+  SUBCASE("Testing contexts created concurrently from a snapshot") {
+    std::vector<std::thread> Threads;
+    std::vector<char> Results(4);
+    for (unsigned I = 0; I < Results.size(); ++I) {
+      Threads.emplace_back([&, I]() {
+        Context Local(*Snapshot);
+        Local.getMutableEngineValue(Table)->store(I * 8, 8, Init);
+        Results[I] = Local.getEngineValue(Table)->getNumFragments() == 1 &&
+                     Local.getEngineValue(Counter)->load(0, 4) == ValueDelegate(Init);
+      });
+    }
+    for (std::thread &Thread : Threads)
+      Thread.join();
+
+    for (char Result : Results)
+      CHECK(Result);
+    CHECK(Snapshot->getEngineValue(Table)->getNumFragments() == 0);
+  }
+}
+
+TEST_CASE("Testing delegates in forked program contexts") {
+  using Context = ProgramContext<passes::DefaultAnalysisIterator>;
+
+  llvm::LLVMContext LLVMContext;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(GlobalsModule, Err, LLVMContext);
+  REQUIRE(M);
+
+  llvm::GlobalVariable *Counter = M->getNamedGlobal("counter");
+  llvm::GlobalVariable *Table = M->getNamedGlobal("table");
+  llvm::Value *Init = llvm::ConstantInt::get(llvm::Type::getInt32Ty(LLVMContext), 7);
+
+  auto Parent = std::make_unique<Context>();
+  Parent->allocateGlobalValues(*M);
+  Parent->getMutableEngineValue(Table)->store(8, 4, Init);
+  ValueDelegate Delegate(Parent->getEngineValue(Table), 8);
+
+  /* The child copies the region it modifies, the region of the parent is freed together with the parent */
+  Context Child = Parent->fork();
+  Child.getMutableEngineValue(Table)->store(0, 4, Init);
+  CHECK(Child.getEngineValue(Table) != Parent->getEngineValue(Table));
+  Parent.reset();
+
+  CHECK(Delegate.getBase() == Table);
+  CHECK(Child.getDelegate(Delegate) == ValueDelegate(Init));
+  CHECK(Delegate == ValueDelegate(Child.getEngineValue(Table), 8));
+  CHECK(hash_value(Delegate) == hash_value(ValueDelegate(Child.getEngineValue(Table), 8)));
+  CHECK(Delegate != ValueDelegate(Child.getEngineValue(Counter), 8));
+}
@@ -0,0 +1,69 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Analysis/StealingWorklist.h>
+
+#include <thread>
+
+using namespace icarus;
+
+TEST_CASE("Testing StealingWorklist") {
+  SUBCASE("Testing local and stolen contexts") {
+    StealingWorklist<unsigned> WL(2);
+    for (unsigned ID = 1; ID <= 3; ++ID)
+      WL.push(0, unsigned(ID));
+
+    /* The owner continues with the newest context, thieves take the oldest one */
+    unsigned Context;
+    REQUIRE(WL.acquire(0, Context));
+    CHECK(Context == 3);
+    WL.release();
+    REQUIRE(WL.acquire(1, Context));
+    CHECK(Context == 1);
+    WL.release();
+
+    StealingStatistics Statistics = WL.getStatistics();
+    CHECK(Statistics.Pushed == 3);
+    CHECK(Statistics.Popped == 1);
+    CHECK(Statistics.Stolen == 1);
+    CHECK(WL.size() == 1);
+  }
+
+  SUBCASE("Testing multiple workers") {
+    StealingWorklist<unsigned> WL(4);
+    std::atomic<unsigned> Executed = 0;
+    std::atomic<unsigned> Checkpoints = 0;
+
+    /* Each context N schedules two contexts N - 1 */
+    WL.push(0, 12U);
+
+    auto Worker = [&](unsigned ID) {
+      unsigned Depth;
+      while (WL.acquire(ID, Depth)) {
+        if (Depth) {
+          WL.push(ID, Depth - 1);
+          WL.push(ID, Depth - 1);
+        }
+        WL.release();
+
+        if (++Executed % 1024 == 0)
+          WL.pause([&](const std::vector<unsigned> &Contexts) { ++Checkpoints; });
+      }
+    };
+
+    std::vector<std::thread> Threads;
+    for (unsigned ID = 0; ID < WL.getNumWorkers(); ++ID)
+      Threads.emplace_back(Worker, ID);
+    for (std::thread &Thread : Threads)
+      Thread.join();
+
+    StealingStatistics Statistics = WL.getStatistics();
+    CHECK(Executed == (1U << 13) - 1);
+    CHECK(Statistics.Popped + Statistics.Stolen == Executed);
+    CHECK(Checkpoints == Executed / 1024);
+    CHECK(WL.size() == 0);
+  }
+}
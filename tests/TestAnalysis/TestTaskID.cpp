@@ -0,0 +1,30 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Analysis/TaskID.h>
+
+using namespace icarus;
+
+TEST_CASE("Testing TaskID order") {
+  TaskID Root(0);
+  TaskID First = Root.getChild(0);
+  TaskID Second = Root.getChild(1);
+
+  CHECK(Root < First);
+  CHECK(First < Second);
+  CHECK(First.getChild(5) < Second);
+  CHECK(Second < TaskID(1));
+  CHECK(!(Second < Second));
+
+  CHECK(Second.getDepth() == 2);
+  CHECK(Second.str() == "0.1");
+  CHECK(Second == Root.getChild(1));
+
+  /* Hashes only depend on the identifier, the seed and the step */
+  CHECK(First.getStableHash(7, 1) == Root.getChild(0).getStableHash(7, 1));
+  CHECK(First.getStableHash(7, 1) != First.getStableHash(7, 2));
+  CHECK(First.getStableHash(7, 1) != Second.getStableHash(7, 1));
+}
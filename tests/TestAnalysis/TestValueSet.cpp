@@ -0,0 +1,90 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+
+#include <icarus/Analysis/ValueSet.h>
+
+#include <vector>
+
+using namespace icarus;
+
+/**
+ * Create the provided number of nodes, each with its own base.
+ */
+static std::vector<EngineValue> createNodes(llvm::LLVMContext &Context, unsigned Num) {
+  std::vector<EngineValue> Nodes;
+  for (unsigned I = 0; I < Num; ++I)
+    Nodes.emplace_back(llvm::ConstantInt::get(llvm::Type::getInt64Ty(Context), I), 16);
+  return Nodes;
+}
+
+TEST_CASE("Testing ValueSet with few elements") {
+  llvm::LLVMContext Context;
+  std::vector<EngineValue> Nodes = createNodes(Context, 3);
+  ValueDelegate A(&Nodes[0]), B(&Nodes[1]), C(&Nodes[2], 8);
+
+  ValueSet Set(A);
+  CHECK(Set.size() == 1);
+  CHECK(Set.getUniqueDelegate() == A);
+  CHECK(!Set.isInterned());
+
+  CHECK(Set.insert(B));
+  CHECK(!Set.insert(B));
+  CHECK(Set.size() == 2);
+  CHECK(!Set.getUniqueDelegate().isValid());
+
+  SUBCASE("Testing equality independent of insertion order") {
+    CHECK(Set == ValueSet({B, A}));
+    CHECK(Set != ValueSet({A, C}));
+    CHECK(hash_value(Set) == hash_value(ValueSet({B, A, B})));
+  }
+
+  SUBCASE("Testing unknown values") {
+    CHECK(ValueSet(ValueDelegate()).isUnknown());
+    CHECK(Set.insert(ValueDelegate()));
+    CHECK(Set.isUnknown());
+    CHECK(!Set.insert(C));
+    CHECK(Set == ValueSet::getUnknown());
+  }
+}
+
+TEST_CASE("Testing interned ValueSet instances") {
+  llvm::LLVMContext Context;
+  std::vector<EngineValue> Nodes = createNodes(Context, 16);
+  std::vector<ValueDelegate> Delegates;
+  for (EngineValue &Node : Nodes)
+    Delegates.emplace_back(&Node);
+
+  ValueSet Lower(llvm::ArrayRef<ValueDelegate>(Delegates).take_front(8));
+  ValueSet Upper(llvm::ArrayRef<ValueDelegate>(Delegates).take_back(8));
+  CHECK(Lower.isInterned());
+  CHECK(Upper.isInterned());
+
+  SUBCASE("Testing that equal sets share their storage") {
+    std::vector<ValueDelegate> Reversed(Delegates.rbegin() + 8, Delegates.rend());
+    ValueSet Other(Reversed);
+    CHECK(Other == Lower);
+    CHECK(Other.elements().data() == Lower.elements().data());
+  }
+
+  SUBCASE("Testing the union of interned sets") {
+    ValueSet All = Lower.merge(Upper);
+    CHECK(All.size() == 16);
+    CHECK(All == ValueSet(Delegates));
+    CHECK(All.elements().data() == Upper.merge(Lower).elements().data());
+    CHECK(All.merge(Lower).elements().data() == All.elements().data());
+    for (const ValueDelegate &D : Delegates)
+      CHECK(All.contains(D));
+  }
+
+  SUBCASE("Testing the union of inline and interned sets") {
+    ValueSet Small(Delegates.front());
+    CHECK(Small.merge(Lower) == Lower);
+    CHECK(!Lower.mergeWith(Small));
+  }
+}
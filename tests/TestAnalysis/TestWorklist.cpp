@@ -0,0 +1,107 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Analysis/Worklist.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace icarus;
+
+namespace {
+
+/* Minimal program context with the properties used by the scheduling policies */
+struct FakeContext {
+  unsigned ID = 0;
+  std::size_t Depth = 0;
+  const llvm::BasicBlock *Block = nullptr;
+
+  std::size_t getStackDepth() const {
+    return Depth;
+  }
+
+  const llvm::BasicBlock *getCurrentBlock() const {
+    return Block;
+  }
+};
+
+std::vector<unsigned> drain(Worklist<FakeContext> &WL) {
+  std::vector<unsigned> Order;
+  FakeContext Context;
+  while (WL.acquire(Context)) {
+    Order.push_back(Context.ID);
+    WL.release();
+  }
+  return Order;
+}
+
+} // namespace
+
+TEST_CASE("Testing Worklist scheduling policies") {
+  SUBCASE("Testing DFS and BFS") {
+    Worklist<FakeContext> DFS(SchedulingPolicy::DFS), BFS(SchedulingPolicy::BFS);
+    for (unsigned ID = 1; ID <= 3; ++ID) {
+      DFS.push({ID});
+      BFS.push({ID});
+    }
+    CHECK(drain(DFS) == std::vector<unsigned>{3, 2, 1});
+    CHECK(drain(BFS) == std::vector<unsigned>{1, 2, 3});
+  }
+
+  SUBCASE("Testing shortest stack first") {
+    Worklist<FakeContext> WL(SchedulingPolicy::ShortestStack);
+    WL.push({1, 3});
+    WL.push({2, 1});
+    WL.push({3, 2});
+    WL.push({4, 1});
+    CHECK(drain(WL) == std::vector<unsigned>{2, 4, 3, 1});
+  }
+
+  SUBCASE("Testing coverage-guided scheduling") {
+    /* The blocks are only used as keys */
+    auto *Covered = reinterpret_cast<const llvm::BasicBlock *>(0x1000);
+    auto *Uncovered = reinterpret_cast<const llvm::BasicBlock *>(0x2000);
+
+    Worklist<FakeContext> WL(SchedulingPolicy::Coverage);
+    WL.recordCoverage({Covered, Covered});
+    WL.push({1, 0, Covered});
+    WL.push({2, 0, Uncovered});
+    CHECK(drain(WL) == std::vector<unsigned>{2, 1});
+  }
+}
+
+TEST_CASE("Testing Worklist with multiple workers") {
+  Worklist<FakeContext> WL(SchedulingPolicy::BFS);
+  std::atomic<unsigned> Executed = 0;
+  std::atomic<unsigned> Snapshots = 0;
+
+  /* Each context with depth N schedules two contexts with depth N - 1 */
+  WL.push({0, 10});
+
+  auto Worker = [&]() {
+    FakeContext Context;
+    while (WL.acquire(Context)) {
+      ++Executed;
+      if (Context.Depth) {
+        WL.push({0, Context.Depth - 1});
+        WL.push({0, Context.Depth - 1});
+      }
+      WL.release();
+
+      if (Executed % 256 == 0)
+        WL.pause([&](const std::vector<FakeContext> &Contexts) { ++Snapshots; });
+    }
+  };
+
+  std::vector<std::thread> Threads;
+  for (unsigned N = 0; N < 4; ++N)
+    Threads.emplace_back(Worker);
+  for (std::thread &Thread : Threads)
+    Thread.join();
+
+  CHECK(Executed == (1U << 11) - 1);
+  CHECK(WL.size() == 0);
+}
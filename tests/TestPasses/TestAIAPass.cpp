@@ -0,0 +1,264 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Passes/AIAPass.h>
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+using namespace icarus;
+using namespace icarus::passes;
+
+static const char *BranchModule = R"(
+define i32 @main(i1 %c) {
+entry:
+  br i1 %c, label %then, label %else
+then:
+  ret i32 1
+else:
+  ret i32 2
+}
+)";
+
+namespace {
+
+/**
+ * Analysis context which follows both successors of conditional branches and records returns.
+ */
+struct BranchContext : public AnalysisContext<DefaultAnalysisIterator, BranchContext> {
+
+  std::vector<std::string> *Returns = nullptr;
+
+  void visitBranchInst(llvm::BranchInst &BI) {
+    if (BI.isConditional()) {
+      ProgramContext<DefaultAnalysisIterator> Forked = PC.fork();
+      Forked.getCurrentFunctionStack().setPosition(BI.getSuccessor(1), 0);
+      fork(std::move(Forked));
+    }
+    PC.getCurrentFunctionStack().setPosition(BI.getSuccessor(0), 0);
+  }
+
+  void visitReturnInst(llvm::ReturnInst &RI) {
+    Returns->push_back(RI.getParent()->getName().str());
+  }
+};
+
+template <bool Threaded> struct BranchPass : public ThreadedAIAPass<BranchContext, Threaded, DefaultAnalysisIterator> {
+
+  std::vector<std::string> Returns;
+
+  bool checkPassArguments(PassArguments &IPA) override {
+    return true;
+  }
+
+  int runAnalysisPass(PassArguments &IPA) override {
+    return 0;
+  }
+
+  void run(llvm::Function &F, SchedulingPolicy Policy, unsigned Quantum) {
+    this->setSchedulingPolicy(Policy);
+    ProgramContext<DefaultAnalysisIterator> PC;
+    PC.pushFunctionContext(F);
+    this->scheduleAnalysisContext(std::move(PC));
+    this->runWorklist(
+        [&]() {
+          BranchContext Context;
+          Context.Returns = &Returns;
+          return Context;
+        },
+        Quantum);
+  }
+};
+
+static const char *LoopModule = R"(
+define i32 @main(i1 %c) {
+entry:
+  br label %loop
+loop:
+  br i1 %c, label %left, label %right
+left:
+  br label %latch
+right:
+  br label %latch
+latch:
+  br i1 %c, label %loop, label %exit
+exit:
+  ret i32 0
+}
+)";
+
+/**
+ * Analysis context which follows both successors in the loop header, leaves the loop at random and logs
+ * a random number for each branch. The visited blocks are buffered until they are committed.
+ */
+struct RandomBranchContext : public AnalysisContext<DefaultAnalysisIterator, RandomBranchContext> {
+
+  std::vector<std::string> *Results = nullptr;
+  std::vector<std::string> Buffered;
+
+  void visitBranchInst(llvm::BranchInst &BI) {
+    llvm::BasicBlock *BB = BI.getParent();
+    uint64_t Random = random();
+    ICARUS_INFO(BB->getName().str(), " ", Random % 1000);
+
+    unsigned Successor = 0;
+    if (BB->getName() == "loop") {
+      ProgramContext<DefaultAnalysisIterator> Forked = PC.fork();
+      Forked.getCurrentFunctionStack().setPosition(BI.getSuccessor(1), 0);
+      fork(std::move(Forked));
+    } else if (BI.isConditional()) {
+      /* Leave the loop with a probability of 3/4 */
+      Successor = Random % 4 != 0;
+    }
+
+    Buffered.push_back(BB->getName().str());
+    PC.getCurrentFunctionStack().setPosition(BI.getSuccessor(Successor), 0);
+  }
+
+  void visitReturnInst(llvm::ReturnInst &RI) {
+    Buffered.push_back("ret");
+  }
+
+  void commit() {
+    Results->insert(Results->end(), Buffered.begin(), Buffered.end());
+    Buffered.clear();
+  }
+};
+
+struct RandomBranchPass : public ThreadedAIAPass<RandomBranchContext, true, DefaultAnalysisIterator> {
+
+  std::vector<std::string> Results;
+  std::vector<std::string> Logs;
+
+  bool checkPassArguments(PassArguments &IPA) override {
+    return true;
+  }
+
+  int runAnalysisPass(PassArguments &IPA) override {
+    return 0;
+  }
+
+  void run(llvm::Function &F, unsigned NumWorkers, uint64_t Seed) {
+    setDeterministic(true, Seed);
+    for (unsigned N = 0; N < 2; ++N) {
+      ProgramContext<DefaultAnalysisIterator> PC;
+      PC.pushFunctionContext(F);
+      scheduleAnalysisContext(std::move(PC));
+    }
+
+    auto CreateContext = [&]() {
+      RandomBranchContext Context;
+      Context.Results = &Results;
+      return Context;
+    };
+
+    logger::LogBuffer Buffer;
+    runRounds(CreateContext, 2, NumWorkers, [](unsigned NumThreads, auto &&Worker) {
+      std::vector<std::thread> Threads;
+      for (unsigned N = 1; N < NumThreads; ++N)
+        Threads.emplace_back([&Worker, N]() { Worker(N); });
+      Worker(0);
+      for (std::thread &Thread : Threads)
+        Thread.join();
+    });
+
+    for (logger::LogMessage &Message : Buffer.take())
+      Logs.push_back(Message.Message);
+  }
+};
+
+} // namespace
+
+TEST_CASE("Testing AIAPass worklist scheduler") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(BranchModule, Err, Context);
+  REQUIRE(M);
+
+  BranchPass<false> Pass;
+
+  SUBCASE("Testing depth-first scheduling") {
+    Pass.run(*M->getFunction("main"), SchedulingPolicy::DFS, 1);
+    CHECK(Pass.Returns == std::vector<std::string>{"then", "else"});
+  }
+
+  SUBCASE("Testing breadth-first scheduling") {
+    Pass.run(*M->getFunction("main"), SchedulingPolicy::BFS, 1);
+    CHECK(Pass.Returns == std::vector<std::string>{"else", "then"});
+  }
+
+  SUBCASE("Testing large quanta") {
+    Pass.run(*M->getFunction("main"), SchedulingPolicy::ShortestStack, 100);
+    CHECK(Pass.Returns.size() == 2);
+  }
+}
+
+TEST_CASE("Testing threaded AIAPass worklist scheduler") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(BranchModule, Err, Context);
+  REQUIRE(M);
+
+  /* Without an initialized thread pool, the current thread is the only worker */
+  BranchPass<true> Pass;
+  Pass.run(*M->getFunction("main"), SchedulingPolicy::DFS, 1);
+  CHECK(Pass.Returns == std::vector<std::string>{"then", "else"});
+  CHECK(Pass.getStealingStatistics().Popped == 3);
+  CHECK(Pass.getStealingStatistics().Stolen == 0);
+}
+
+TEST_CASE("Testing exceptions of scheduled tasks") {
+  ThreadPool::initialize(2);
+
+  /* The exception is logged, so that the worker survives and executes the following task */
+  BranchPass<true> Pass;
+  std::atomic<bool> Executed = false;
+  Pass.schedule([]() { throw std::runtime_error("Failure"); });
+  Pass.schedule([&Executed]() { Executed = true; });
+
+  ThreadPool::awaitCompletion();
+  ThreadPool::shutdown();
+  CHECK(Executed);
+}
+
+TEST_CASE("Testing deterministic AIAPass execution") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(LoopModule, Err, Context);
+  REQUIRE(M);
+
+  logger::setDeterministicOutput(true);
+
+  RandomBranchPass Sequential;
+  Sequential.run(*M->getFunction("main"), 1, 42);
+  REQUIRE(!Sequential.Results.empty());
+  CHECK(Sequential.Logs.size() == Sequential.Results.size() - std::count(Sequential.Results.begin(),
+                                                                          Sequential.Results.end(), "ret"));
+
+  SUBCASE("Testing identical output with multiple workers") {
+    for (unsigned Run = 0; Run < 4; ++Run) {
+      RandomBranchPass Parallel;
+      Parallel.run(*M->getFunction("main"), 4, 42);
+      CHECK(Parallel.Results == Sequential.Results);
+      CHECK(Parallel.Logs == Sequential.Logs);
+    }
+  }
+
+  SUBCASE("Testing different seeds") {
+    RandomBranchPass Other;
+    Other.run(*M->getFunction("main"), 4, 43);
+    CHECK(Other.Logs != Sequential.Logs);
+  }
+
+  logger::setDeterministicOutput(false);
+}
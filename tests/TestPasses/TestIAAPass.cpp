@@ -0,0 +1,151 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Passes/IAAPass.h>
+#include <icarus/Passes/PassArguments.h>
+
+#include <fstream>
+
+using namespace icarus;
+using namespace icarus::passes;
+
+static const char *InputModule = R"(
+@g = global i32 0
+@llvm.global_ctors = appending global [1 x { i32, void ()*, i8* }]
+    [{ i32, void ()*, i8* } { i32 65535, void ()* @init, i8* null }]
+
+define void @init() {
+entry:
+  store i32 1, i32* @g
+  ret void
+}
+
+define i32 @main(i32 %x) {
+entry:
+  ret i32 %x
+}
+)";
+
+namespace {
+
+struct SnapshotIAAPass : public IAAPass {
+  const GlobalSnapshot &getSnapshot() {
+    return getGlobalSnapshot([](ProgramContext<IAAContext::Iter> &) {});
+  }
+};
+
+struct CheckpointIAAPass : public IAAPass {
+  using Iter = IAAContext::Iter;
+
+  /* Write a checkpoint of a single program context, interrupted in the entry block of the function */
+  void checkpoint(llvm::Function &F, llvm::Constant *Arg) {
+    ProgramContext<Iter> PC = createProgramContext([](ProgramContext<Iter> &) {});
+    PC.pushFunctionContext(F).setValue(F.getArg(0), ValueDelegate(Arg));
+    std::vector<ProgramContext<Iter>> Contexts;
+    Contexts.push_back(std::move(PC));
+    checkpointContexts(Contexts);
+  }
+
+  std::vector<ProgramContext<Iter>> resume() {
+    if (!resumeFromCheckpoint())
+      return {};
+    return takeScheduledContexts();
+  }
+};
+
+} // namespace
+
+TEST_CASE("Testing IAAPass") {
+  SUBCASE("Testing static constructors") {
+    llvm::LLVMContext Context;
+    llvm::SMDiagnostic Err;
+    std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(InputModule, Err, Context);
+    REQUIRE(M);
+
+    ProgramContext<IAAContext::Iter> PC;
+    IAAContext Ctx(PC, M->getDataLayout());
+    Ctx.executeCtors(M.get());
+
+    std::vector<const llvm::BasicBlock *> Visited = Ctx.takeVisitedBlocks();
+    CHECK(Visited == std::vector<const llvm::BasicBlock *>{&M->getFunction("init")->getEntryBlock()});
+    CHECK(Ctx.getProgramContext().isStackEmpty());
+  }
+
+  SUBCASE("Testing initial program contexts") {
+    llvm::SmallString<128> ModulePath, JSONPath;
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "ll", ModulePath));
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "json", JSONPath));
+    std::ofstream(ModulePath.str().str()) << InputModule;
+    std::ofstream(JSONPath.str().str())
+        << R"({"variables": {"g": "i32 42"}, "functions": [{"func": "main", "args": {"0": "i32 7"}}]})";
+
+    PassArguments IPA(ModulePath.str().str(), JSONPath.str().str(), 1);
+    REQUIRE(IPA.getNumFiles() == 1);
+
+    SnapshotIAAPass Pass;
+    REQUIRE(Pass.checkPassArguments(IPA));
+    CHECK(Pass.runAnalysisPass(IPA) == 0);
+
+    /* The snapshot has been created by the pass, with the value of the variable from the JSON file */
+    llvm::Module *IM = IPA.getModuleAt(0)->getModule();
+    const EngineValue *EV = Pass.getSnapshot().getEngineValue(IM->getNamedGlobal("g"));
+    REQUIRE(EV);
+    CHECK(EV->getSize() == 4);
+    CHECK(EV->load(0, 4) == ValueDelegate(llvm::ConstantInt::get(llvm::Type::getInt32Ty(IM->getContext()), 42)));
+
+    llvm::sys::fs::remove(ModulePath);
+    llvm::sys::fs::remove(JSONPath);
+  }
+
+  SUBCASE("Testing checkpoint and resume") {
+    llvm::SmallString<128> ModulePath, JSONPath, CheckpointPath;
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "ll", ModulePath));
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "json", JSONPath));
+    REQUIRE(!llvm::sys::fs::createTemporaryFile("icarus", "ckpt", CheckpointPath));
+    std::ofstream(ModulePath.str().str()) << InputModule;
+    std::ofstream(JSONPath.str().str()) << R"({"functions": [{"func": "main", "args": {"0": "i32 7"}}]})";
+
+    PassArguments IPA(ModulePath.str().str(), JSONPath.str().str(), 1);
+    REQUIRE(IPA.getNumFiles() == 1);
+    llvm::Module *IM = IPA.getModuleAt(0)->getModule();
+    llvm::Function *Main = IM->getFunction("main");
+    /* Only constants used by instructions of the module can be restored, such as the one stored in @init */
+    llvm::Constant *One = llvm::ConstantInt::get(llvm::Type::getInt32Ty(IM->getContext()), 1);
+
+    IPA.setCheckpointOptions(CheckpointPath.str().str(), 0, false);
+    CheckpointIAAPass Interrupted;
+    REQUIRE(Interrupted.checkPassArguments(IPA));
+    Interrupted.checkpoint(*Main, One);
+
+    IPA.setCheckpointOptions(CheckpointPath.str().str(), 0, true);
+    CheckpointIAAPass Resumed;
+    REQUIRE(Resumed.checkPassArguments(IPA));
+    std::vector<ProgramContext<IAAContext::Iter>> Contexts = Resumed.resume();
+
+    REQUIRE(Contexts.size() == 1);
+    REQUIRE(Contexts[0].getStackDepth() == 1);
+    auto &FC = Contexts[0].getCurrentFunctionStack();
+    CHECK(FC.getFunction() == Main);
+    CHECK(FC.getPosition() == 0);
+    CHECK(FC.getValue(Main->getArg(0)) == ValueDelegate(One));
+
+    /* Without a checkpoint file, the pass does not resume */
+    llvm::sys::fs::remove(CheckpointPath);
+    CheckpointIAAPass Fresh;
+    REQUIRE(Fresh.checkPassArguments(IPA));
+    CHECK(Fresh.resume().empty());
+
+    llvm::sys::fs::remove(ModulePath);
+    llvm::sys::fs::remove(JSONPath);
+  }
+}
@@ -16,9 +16,10 @@ TEST_CASE("Testing ICCPass") {
   PassArguments IPA(SAMPLES_DIR "/indirect_calls.ll", "", 2);
 
   passes::ICCPass ICCPass;
+  /* The pass initializes the thread pool with the number of threads of the pass arguments */
   CHECK(ICCPass.checkPassArguments(IPA));
+  CHECK(ThreadPool::getThreadNum() == IPA.getNumThreads() - 1);
 
-  ThreadPool::initialize(IPA.getNumThreads());
   logger::initLoggerOptions("", "");
 
   int Ret = ICCPass.runAnalysisPass(IPA);
@@ -0,0 +1,122 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Passes/InstDispatch.h>
+
+using namespace icarus::passes;
+
+static const char *DispatchModule = R"(
+define i32 @main(i32 %a, i32 %b) {
+entry:
+  %add = add i32 %a, %b
+  %mul = mul i32 %add, %b
+  %cmp = icmp eq i32 %mul, 0
+  br i1 %cmp, label %exit, label %exit
+exit:
+  ret i32 %add
+}
+)";
+
+namespace {
+
+struct ReturnVisitor : public llvm::InstVisitor<ReturnVisitor> {
+  void visitReturnInst(llvm::ReturnInst &RI) {}
+};
+
+struct BinaryVisitor : public llvm::InstVisitor<BinaryVisitor> {
+  std::vector<std::string> Visited;
+
+  void visitAdd(llvm::BinaryOperator &BO) {
+    Visited.push_back("add");
+  }
+
+  void visitBinaryOperator(llvm::BinaryOperator &BO) {
+    Visited.push_back(BO.getOpcodeName());
+  }
+};
+
+struct CastVisitor : public llvm::InstVisitor<CastVisitor, unsigned> {
+  unsigned visitCastInst(llvm::CastInst &CI) {
+    return 1;
+  }
+
+  unsigned visitInstruction(llvm::Instruction &I) {
+    return 2;
+  }
+};
+
+struct MemCpyVisitor : public llvm::InstVisitor<MemCpyVisitor> {
+  void visitMemCpyInst(llvm::MemCpyInst &MCI) {}
+};
+
+struct InterceptVisitor : public llvm::InstVisitor<InterceptVisitor, unsigned> {
+  unsigned visit(llvm::Instruction &I) {
+    return 3;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Testing InstDispatchTable handlers") {
+  using ReturnTable = InstDispatchTable<ReturnVisitor, void>;
+  static_assert(ReturnTable::isHandled(llvm::Instruction::Ret));
+  static_assert(!ReturnTable::isHandled(llvm::Instruction::Br));
+  static_assert(!ReturnTable::isHandled(llvm::Instruction::Add));
+
+  using BinaryTable = InstDispatchTable<BinaryVisitor, void>;
+  static_assert(BinaryTable::isHandled(llvm::Instruction::Add));
+  static_assert(BinaryTable::isHandled(llvm::Instruction::Mul));
+  static_assert(!BinaryTable::isHandled(llvm::Instruction::ICmp));
+
+  /* Visitors of abstract instruction classes enable all handlers */
+  using CastTable = InstDispatchTable<CastVisitor, unsigned>;
+  static_assert(CastTable::isHandled(llvm::Instruction::Ret));
+  static_assert(CastTable::isHandled(llvm::Instruction::Load));
+
+  /* Visitors of intrinsics only enable the handler for calls */
+  using MemCpyTable = InstDispatchTable<MemCpyVisitor, void>;
+  static_assert(MemCpyTable::isHandled(llvm::Instruction::Call));
+  static_assert(!MemCpyTable::isHandled(llvm::Instruction::Load));
+
+  using InterceptTable = InstDispatchTable<InterceptVisitor, unsigned>;
+  static_assert(InterceptTable::isHandled(llvm::Instruction::Store));
+
+  CHECK(!ReturnTable::isHandled(ReturnTable::NumOpcodes));
+}
+
+TEST_CASE("Testing InstDispatchTable delegation") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(DispatchModule, Err, Context);
+  REQUIRE(M);
+
+  /* Handlers must produce the same results as llvm::InstVisitor::visit */
+  BinaryVisitor Binary, Expected;
+  CastVisitor Cast;
+  InterceptVisitor Intercept;
+  for (llvm::Instruction &I : llvm::instructions(*M->getFunction("main"))) {
+    using BinaryTable = InstDispatchTable<BinaryVisitor, void>;
+    if (BinaryTable::isHandled(I.getOpcode()))
+      BinaryTable::Handlers[I.getOpcode()](Binary, I);
+    Expected.visit(I);
+
+    using CastTable = InstDispatchTable<CastVisitor, unsigned>;
+    CHECK(CastTable::Handlers[I.getOpcode()](Cast, I) == Cast.visit(I));
+
+    using InterceptTable = InstDispatchTable<InterceptVisitor, unsigned>;
+    CHECK(InterceptTable::Handlers[I.getOpcode()](Intercept, I) == 3);
+  }
+
+  CHECK(Binary.Visited == std::vector<std::string>{"add", "mul"});
+  CHECK(Binary.Visited == Expected.Visited);
+}
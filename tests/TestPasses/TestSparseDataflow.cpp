@@ -0,0 +1,138 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include <icarus/Passes/SparseDataflow.h>
+
+using namespace icarus;
+using namespace icarus::passes;
+
+static const char *ConstantModule = R"(
+define i32 @main(i32 %n) {
+entry:
+  %five = add i32 2, 3
+  br label %loop
+loop:
+  %x = phi i32 [ 1, %entry ], [ %x.next, %loop ]
+  %i = phi i32 [ 0, %entry ], [ %i.next, %loop ]
+  %x.next = mul i32 %x, 1
+  %i.next = add i32 %i, 1
+  %cmp = icmp slt i32 %i.next, %n
+  br i1 %cmp, label %loop, label %exit
+exit:
+  %sum = add i32 %x.next, %five
+  %arg = add i32 %sum, %n
+  ret i32 %sum
+}
+)";
+
+namespace {
+
+/**
+ * Lattice of constant propagation: unknown (bottom), a single constant or overdefined (top).
+ */
+struct ConstantState {
+  enum { Unknown, Constant, Overdefined } Kind = Unknown;
+  int64_t Value = 0;
+};
+
+struct ConstantContext : public SparseAnalysisContext<ConstantContext, ConstantState> {
+
+  ConstantState getBottom() {
+    return {};
+  }
+
+  ConstantState getValueState(llvm::Value &V) {
+    if (auto *CI = llvm::dyn_cast<llvm::ConstantInt>(&V))
+      return {ConstantState::Constant, CI->getSExtValue()};
+    return {ConstantState::Overdefined, 0};
+  }
+
+  bool join(ConstantState &State, const ConstantState &Other) {
+    if (Other.Kind == ConstantState::Unknown || State.Kind == ConstantState::Overdefined)
+      return false;
+    if (State.Kind == ConstantState::Unknown) {
+      State = Other;
+      return true;
+    }
+    if (Other.Kind == ConstantState::Constant && Other.Value == State.Value)
+      return false;
+    State.Kind = ConstantState::Overdefined;
+    return true;
+  }
+
+  ConstantState visitPHINode(llvm::PHINode &Phi) {
+    ConstantState State;
+    for (llvm::Value *Incoming : Phi.incoming_values())
+      join(State, getState(Incoming));
+    return State;
+  }
+
+  ConstantState visitBinaryOperator(llvm::BinaryOperator &BO) {
+    ConstantState LHS = getState(BO.getOperand(0));
+    ConstantState RHS = getState(BO.getOperand(1));
+    if (LHS.Kind == ConstantState::Overdefined || RHS.Kind == ConstantState::Overdefined)
+      return {ConstantState::Overdefined, 0};
+    if (LHS.Kind == ConstantState::Unknown || RHS.Kind == ConstantState::Unknown)
+      return {};
+
+    switch (BO.getOpcode()) {
+    case llvm::Instruction::Add:
+      return {ConstantState::Constant, LHS.Value + RHS.Value};
+    case llvm::Instruction::Mul:
+      return {ConstantState::Constant, LHS.Value * RHS.Value};
+    default:
+      return {ConstantState::Overdefined, 0};
+    }
+  }
+};
+
+llvm::Value *getValue(llvm::Function &F, llvm::StringRef Name) {
+  for (llvm::BasicBlock &BB : F)
+    for (llvm::Instruction &I : BB)
+      if (I.getName() == Name)
+        return &I;
+  return nullptr;
+}
+
+} // namespace
+
+TEST_CASE("Testing sparse constant propagation") {
+  llvm::LLVMContext Context;
+  llvm::SMDiagnostic Err;
+  std::unique_ptr<llvm::Module> M = llvm::parseAssemblyString(ConstantModule, Err, Context);
+  REQUIRE(M);
+
+  llvm::Function &F = *M->getFunction("main");
+  ConstantContext Constants;
+  SparseDataflow<ConstantContext> Solver(Constants, F);
+  unsigned NumTransfers = Solver.solve();
+
+  auto IsConstant = [&](llvm::StringRef Name, int64_t Value) {
+    ConstantState State = Solver.getState(getValue(F, Name));
+    return State.Kind == ConstantState::Constant && State.Value == Value;
+  };
+  auto IsOverdefined = [&](llvm::StringRef Name) {
+    return Solver.getState(getValue(F, Name)).Kind == ConstantState::Overdefined;
+  };
+
+  CHECK(IsConstant("five", 5));
+  CHECK(IsConstant("x", 1));
+  CHECK(IsConstant("x.next", 1));
+  CHECK(IsConstant("sum", 6));
+  CHECK(IsOverdefined("i"));
+  CHECK(IsOverdefined("i.next"));
+  CHECK(IsOverdefined("arg"));
+
+  /* Comparisons, branches and returns are not handled by the analysis and never evaluated */
+  CHECK(Solver.getState(getValue(F, "cmp")).Kind == ConstantState::Unknown);
+  CHECK(NumTransfers < 20);
+  CHECK(NumTransfers >= 7);
+}
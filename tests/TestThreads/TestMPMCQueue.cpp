@@ -0,0 +1,93 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Threads/MPMCQueue.h>
+
+#include <vector>
+
+using namespace icarus;
+
+struct IntQueue : public MPMCQueue<IntQueue, unsigned, 8> {};
+struct PointerQueue : public MPMCQueue<PointerQueue, std::unique_ptr<unsigned>, 4> {};
+
+TEST_CASE("Testing MPMCQueue") {
+  SUBCASE("Testing order and capacity") {
+    IntQueue Queue;
+    CHECK(Queue.empty());
+    for (unsigned N = 0; N < 8; ++N)
+      CHECK(Queue.tryPush(unsigned(N)));
+    CHECK_FALSE(Queue.tryPush(8));
+    CHECK(Queue.size() == 8);
+
+    /* Wrap around the ring buffer a few times */
+    unsigned Value;
+    for (unsigned N = 0; N < 20; ++N) {
+      REQUIRE(Queue.tryPop(Value));
+      CHECK(Value == N);
+      CHECK(Queue.tryPush(N + 8));
+    }
+    CHECK(Queue.size() == 8);
+  }
+
+  SUBCASE("Testing elements with ownership") {
+    PointerQueue Queue;
+    Queue.push(std::make_unique<unsigned>(1));
+    Queue.push(std::make_unique<unsigned>(2));
+
+    std::unique_ptr<unsigned> Element;
+    REQUIRE(Queue.pop(Element));
+    CHECK(*Element == 1);
+
+    /* A failed push does not move from the element, remaining elements are destroyed with the queue */
+    for (unsigned N = 0; N < 3; ++N)
+      Queue.push(std::make_unique<unsigned>(N));
+    CHECK_FALSE(Queue.tryPush(std::move(Element)));
+    CHECK(Element);
+  }
+
+  SUBCASE("Testing blocking producers and consumers") {
+    constexpr unsigned NumThreads = 4;
+    constexpr unsigned NumElements = 20000;
+
+    /* The small capacity forces producers and consumers to wait for each other */
+    IntQueue Queue;
+    std::atomic<uint64_t> Sum = 0;
+    std::vector<std::thread> Threads;
+    for (unsigned N = 0; N < NumThreads; ++N) {
+      Threads.emplace_back([&]() {
+        unsigned Value;
+        while (Queue.pop(Value) && Value)
+          Sum.fetch_add(Value);
+      });
+      Threads.emplace_back([&]() {
+        for (unsigned Value = 1; Value <= NumElements; ++Value)
+          Queue.push(unsigned(Value));
+      });
+    }
+
+    for (unsigned N = 0; N < NumThreads; ++N)
+      Threads[2 * N + 1].join();
+    for (unsigned N = 0; N < NumThreads; ++N)
+      Queue.push(0);
+    for (unsigned N = 0; N < NumThreads; ++N)
+      Threads[2 * N].join();
+
+    CHECK(Sum.load() == uint64_t(NumThreads) * NumElements * (NumElements + 1) / 2);
+    CHECK(Queue.empty());
+  }
+
+  SUBCASE("Testing invalidation") {
+    IntQueue Queue;
+    std::atomic<bool> Popped = true;
+    std::thread Consumer([&]() {
+      unsigned Value;
+      Popped = Queue.pop(Value);
+    });
+    Queue.invalidate();
+    Consumer.join();
+    CHECK_FALSE(Popped.load());
+  }
+}
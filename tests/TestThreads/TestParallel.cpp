@@ -0,0 +1,112 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Threads/ThreadPool.h>
+
+#include <list>
+#include <numeric>
+
+using namespace icarus;
+
+/**
+ * Runs the loops of the test with the current configuration of the thread pool.
+ */
+static void checkParallelLoops() {
+  SUBCASE("Testing parallelFor over indices") {
+    std::vector<std::atomic<unsigned>> Visited(1000);
+    ThreadPool::parallelFor(0, 1000, [&](int N) { Visited[N].fetch_add(1); });
+    CHECK(std::all_of(Visited.begin(), Visited.end(), [](auto &V) { return V.load() == 1; }));
+
+    /* Empty and reversed ranges do not call the function */
+    ThreadPool::parallelFor(5, 5, [](int N) { FAIL("Unexpected iteration"); });
+    ThreadPool::parallelFor(5, 2, [](int N) { FAIL("Unexpected iteration"); });
+
+    /* Explicit grain sizes, including one which does not divide the range */
+    std::atomic<unsigned> Sum = 0;
+    ThreadPool::parallelFor(10U, 110U, [&](unsigned N) { Sum.fetch_add(N); }, 7);
+    CHECK(Sum == 5950);
+  }
+
+  SUBCASE("Testing parallelFor over iterators") {
+    std::vector<unsigned> Values(1000, 1);
+    ThreadPool::parallelFor(Values.begin(), Values.end(), [](unsigned &V) { V *= 2; });
+    CHECK(std::accumulate(Values.begin(), Values.end(), 0U) == 2000);
+
+    /* Iterators which are not random access iterators */
+    std::list<unsigned> List(500, 1);
+    ThreadPool::parallelFor(List.begin(), List.end(), [](unsigned &V) { V += 2; });
+    CHECK(std::accumulate(List.begin(), List.end(), 0U) == 1500);
+  }
+
+  SUBCASE("Testing parallelReduce") {
+    auto Add = [](unsigned long &Result, unsigned long Value) { Result += Value; };
+    CHECK(ThreadPool::parallelReduce(
+              1UL, 10001UL, 0UL, [](unsigned long &Acc, unsigned long N) { Acc += N; }, Add) == 50005000);
+    CHECK(ThreadPool::parallelReduce(
+              1UL, 21UL, 1UL, [](unsigned long &Acc, unsigned long N) { Acc *= N; },
+              [](unsigned long &Result, unsigned long Value) { Result *= Value; }) == 2432902008176640000UL);
+
+    /* Empty ranges return the identity */
+    CHECK(ThreadPool::parallelReduce(
+              0, 0, 1UL, [](unsigned long &Acc, int N) { Acc *= N; },
+              [](unsigned long &Result, unsigned long Value) { Result *= Value; }) == 1);
+
+    /* Accumulators which are not trivially copyable */
+    std::list<std::string> Words = {"a", "bb", "a", "ccc", "bb", "a"};
+    auto Counts = ThreadPool::parallelReduce(
+        Words.begin(), Words.end(), std::map<std::string, unsigned>(),
+        [](std::map<std::string, unsigned> &Acc, const std::string &Word) { Acc[Word]++; },
+        [](std::map<std::string, unsigned> &Result, std::map<std::string, unsigned> &&Acc) {
+          for (auto &[Word, Count] : Acc)
+            Result[Word] += Count;
+        },
+        1);
+    CHECK(Counts == std::map<std::string, unsigned>{{"a", 3}, {"bb", 2}, {"ccc", 1}});
+  }
+
+  SUBCASE("Testing nested loops") {
+    unsigned long Sum = ThreadPool::parallelReduce(
+        0U, 50U, 0UL,
+        [](unsigned long &Acc, unsigned I) {
+          Acc += ThreadPool::parallelReduce(
+              0U, 100U, 0UL, [I](unsigned long &Inner, unsigned J) { Inner += I * J; },
+              [](unsigned long &Result, unsigned long Value) { Result += Value; });
+        },
+        [](unsigned long &Result, unsigned long Value) { Result += Value; });
+    CHECK(Sum == 1225UL * 4950UL);
+  }
+
+  SUBCASE("Testing exceptions in loops") {
+    std::atomic<unsigned> Iterations = 0;
+    CHECK_THROWS_AS(ThreadPool::parallelFor(
+                        0, 1000,
+                        [&](int N) {
+                          Iterations.fetch_add(1);
+                          if (N == 10)
+                            throw std::runtime_error("Iteration failed");
+                        },
+                        1),
+                    std::runtime_error);
+
+    /* The loop can be executed again afterwards */
+    std::atomic<unsigned> Count = 0;
+    ThreadPool::parallelFor(0, 100, [&](int N) { Count.fetch_add(1); });
+    CHECK(Count == 100);
+  }
+}
+
+TEST_CASE("Testing parallel loops") {
+  SUBCASE("Testing loops without threads") {
+    REQUIRE(ThreadPool::getThreadNum() == 0);
+    checkParallelLoops();
+  }
+
+  SUBCASE("Testing loops with threads") {
+    ThreadPool::initialize(4);
+    checkParallelLoops();
+    ThreadPool::shutdown();
+  }
+}
@@ -0,0 +1,86 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Threads/TaskGroup.h>
+
+#include <memory>
+
+using namespace icarus;
+
+/**
+ * Fork-join computation of the Fibonacci numbers, where each task waits for the group of its subtasks.
+ */
+static unsigned fibonacci(unsigned N) {
+  if (N < 2)
+    return N;
+
+  unsigned Left, Right;
+  TaskGroup Group;
+  Group.run([&]() { Left = fibonacci(N - 1); });
+  Group.run([&]() { Right = fibonacci(N - 2); });
+  Group.wait();
+  return Left + Right;
+}
+
+TEST_CASE("Testing TaskGroup") {
+  SUBCASE("Testing groups without threads") {
+    REQUIRE(ThreadPool::getThreadNum() == 0);
+    CHECK(fibonacci(15) == 610);
+
+    TaskGroup Group;
+    Group.run([]() { throw std::runtime_error("Task failed"); });
+    CHECK_THROWS_AS(Group.wait(), std::runtime_error);
+    CHECK_NOTHROW(Group.wait());
+  }
+
+  SUBCASE("Testing groups with threads") {
+    /* Nested groups need more threads than the pool has, unless waiting threads execute pending tasks */
+    ThreadPool::initialize(3);
+    CHECK(fibonacci(18) == 2584);
+
+    /* Waiting for a group does not wait for other tasks in the pool, which are already running */
+    std::atomic<bool> Started = false;
+    std::atomic<bool> Release = false;
+    std::atomic<bool> Finished = false;
+    ThreadPool::post([&]() {
+      Started = true;
+      while (!Release.load())
+        std::this_thread::yield();
+      Finished = true;
+    });
+    while (!Started.load())
+      std::this_thread::yield();
+
+    std::atomic<unsigned> Executed = 0;
+    TaskGroup Group;
+    for (unsigned N = 0; N < 100; ++N)
+      Group.run([&]() { Executed.fetch_add(1); });
+    Group.run([]() { throw std::runtime_error("Task failed"); });
+    CHECK_THROWS_AS(Group.wait(), std::runtime_error);
+    CHECK(Executed.load() == 100);
+    CHECK_FALSE(Finished.load());
+
+    Release = true;
+    ThreadPool::awaitCompletion();
+    CHECK(Finished.load());
+    ThreadPool::shutdown();
+  }
+
+  SUBCASE("Testing groups destroyed right after waiting") {
+    /* The last finishing task must not access the group, which is destroyed as soon as wait returns */
+    ThreadPool::initialize(5);
+    std::atomic<unsigned> Executed = 0;
+    for (unsigned N = 0; N < 2000; ++N) {
+      auto Group = std::make_unique<TaskGroup>();
+      for (unsigned I = 0; I < 4; ++I)
+        Group->run([&]() { Executed.fetch_add(1); });
+      Group->wait();
+      Group.reset();
+    }
+    CHECK(Executed.load() == 8000);
+    ThreadPool::shutdown();
+  }
+}
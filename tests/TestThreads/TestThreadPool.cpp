@@ -0,0 +1,321 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Threads/TaskGroup.h>
+#include <icarus/Threads/ThreadPool.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <string>
+
+using namespace icarus;
+
+/**
+ * Submit a binary tree of tasks from within the thread pool, so that tasks are pushed to the deques of the
+ * workers and distributed by stealing.
+ */
+static void spawn(unsigned Depth, std::atomic<unsigned> &Executed) {
+  Executed.fetch_add(1);
+  if (!Depth)
+    return;
+  ThreadPool::post(spawn, Depth - 1, std::ref(Executed));
+  ThreadPool::post(spawn, Depth - 1, std::ref(Executed));
+}
+
+TEST_CASE("Testing ThreadPool") {
+  ThreadPool::initialize(4);
+  REQUIRE(ThreadPool::getThreadNum() == 3);
+
+  SUBCASE("Testing futures of external tasks") {
+    std::vector<TaskFuture<unsigned>> Futures;
+    for (unsigned N = 0; N < 100; ++N)
+      Futures.push_back(ThreadPool::submit([](unsigned N) { return N * N; }, N));
+
+    unsigned Sum = 0;
+    for (TaskFuture<unsigned> &Future : Futures)
+      Sum += Future.get();
+    CHECK(Sum == 328350);
+  }
+
+  SUBCASE("Testing tasks submitted by workers") {
+    std::atomic<unsigned> Executed = 0;
+    ThreadPool::post(spawn, 12, std::ref(Executed));
+    ThreadPool::awaitCompletion();
+    CHECK(Executed.load() == (1U << 13) - 1);
+  }
+
+  SUBCASE("Testing results of futures") {
+    /* Callables too large for the inline storage of a task are allocated separately */
+    std::array<unsigned, 32> Large;
+    Large.fill(3);
+    TaskFuture<unsigned> LargeFuture = ThreadPool::submit([Large]() { return Large[0] + Large[31]; });
+    TaskFuture<void> ThrowingFuture = ThreadPool::submit([]() { throw std::runtime_error("Task failed"); });
+    TaskFuture<std::string> StringFuture = ThreadPool::submit([]() { return std::string(100, 'x'); });
+
+    CHECK(LargeFuture.get() == 6);
+    CHECK_FALSE(LargeFuture.valid());
+    CHECK_THROWS_AS(ThrowingFuture.get(), std::runtime_error);
+    StringFuture.wait();
+    CHECK(StringFuture.isReady());
+    CHECK(StringFuture.get().size() == 100);
+  }
+
+  SUBCASE("Testing thread IDs") {
+    CHECK(ThreadPool::getThreadID() == 0);
+
+    /* Each task waits for the other ones, so that every worker executes exactly one of them */
+    std::atomic<unsigned> Arrived = 0;
+    std::array<std::atomic<unsigned>, 4> IDs = {};
+    for (unsigned N = 0; N < 3; ++N) {
+      ThreadPool::post([&]() {
+        IDs[ThreadPool::getThreadID()].fetch_add(1);
+        Arrived.fetch_add(1);
+        while (Arrived.load() < 3)
+          std::this_thread::yield();
+      });
+    }
+    ThreadPool::awaitCompletion();
+
+    CHECK(IDs[0].load() == 0);
+    CHECK(IDs[1].load() == 1);
+    CHECK(IDs[2].load() == 1);
+    CHECK(IDs[3].load() == 1);
+  }
+
+  ThreadPool::shutdown();
+}
+
+TEST_CASE("Testing independent pools") {
+  ThreadPool A(3);
+  ThreadPool B(2);
+  REQUIRE(A.doSubmit([]() { return ThreadPool::getCurrentThreadNum(); }).get() == 2);
+  REQUIRE(B.doSubmit([]() { return ThreadPool::getCurrentThreadNum(); }).get() == 1);
+  CHECK(ThreadPool::getThreadNum() == 0);
+  CHECK(ThreadPool::getCurrentThreadNum() == 0);
+  CHECK(&ThreadPool::getCurrent() == &ThreadPool::getDefault());
+
+  SUBCASE("Testing current pool of workers") {
+    TaskFuture<ThreadPool *> FromA = A.doSubmit([]() { return &ThreadPool::getCurrent(); });
+    TaskFuture<ThreadPool *> FromB = B.doSubmit([]() { return &ThreadPool::getCurrent(); });
+    CHECK(FromA.get() == &A);
+    CHECK(FromB.get() == &B);
+  }
+
+  SUBCASE("Testing loops and groups of pools") {
+    unsigned Sum = A.doParallelReduce(
+        0U, 1000U, 0U, [](unsigned &Acc, unsigned N) { Acc += N; },
+        [](unsigned &Result, unsigned Acc) { Result += Acc; });
+    CHECK(Sum == 499500);
+
+    std::atomic<unsigned> Executed = 0;
+    TaskGroup Group(B);
+    for (unsigned N = 0; N < 100; ++N)
+      Group.run([&]() { Executed.fetch_add(1); });
+    Group.wait();
+    CHECK(Executed == 100);
+  }
+
+  SUBCASE("Testing thread IDs of pools") {
+    /* Each task waits for the other ones, so that every worker executes exactly one of them */
+    std::atomic<unsigned> Arrived = 0;
+    auto GetID = [&]() {
+      Arrived.fetch_add(1);
+      while (Arrived.load() < 3)
+        std::this_thread::yield();
+      return ThreadPool::getThreadID();
+    };
+    std::array<TaskFuture<unsigned>, 3> Futures = {A.doSubmit(GetID), A.doSubmit(GetID), B.doSubmit(GetID)};
+    std::array<unsigned, 3> IDs = {Futures[0].get(), Futures[1].get(), Futures[2].get()};
+
+    /* The workers of additional pools neither share IDs with each other nor with the default pool */
+    CHECK(std::max(IDs[0], IDs[1]) == std::min(IDs[0], IDs[1]) + 1);
+    CHECK(std::min(IDs[0], IDs[1]) > 1);
+    CHECK(IDs[2] > 1);
+    CHECK(IDs[2] != IDs[0]);
+    CHECK(IDs[2] != IDs[1]);
+  }
+
+  SUBCASE("Testing reinitialization") {
+    ThreadPool::initialize(3);
+    ThreadPool::initialize(2);
+    CHECK(ThreadPool::getThreadNum() == 1);
+    CHECK(ThreadPool::submit([]() { return ThreadPool::getThreadID(); }).get() == 1);
+    ThreadPool::shutdown();
+  }
+}
+
+TEST_CASE("Testing idle threads") {
+  ThreadPool::IdleOptions Options;
+  SUBCASE("Testing threads sleeping immediately") {
+    Options.SpinRounds = 0;
+  }
+  SUBCASE("Testing threads spinning until they find a task") {
+    Options.SpinRounds = ~0U;
+    Options.MaxBackoff = 16;
+  }
+
+  ThreadPool::setIdleOptions(Options);
+  ThreadPool::initialize(4);
+
+  /* Bursts of tasks with pauses in between, so that idle threads go to sleep between the bursts */
+  for (unsigned Burst = 0; Burst < 20; ++Burst) {
+    std::atomic<unsigned> Executed = 0;
+    ThreadPool::post(spawn, 5, std::ref(Executed));
+    ThreadPool::awaitCompletion();
+    CHECK(Executed == 63);
+
+    std::atomic<unsigned> Joined = 0;
+    TaskGroup Group;
+    for (unsigned N = 0; N < 16; ++N)
+      Group.run([&]() { Joined.fetch_add(1); });
+    Group.wait();
+    CHECK(Joined == 16);
+
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+
+  ThreadPool::shutdown();
+  ThreadPool::setIdleOptions(ThreadPool::IdleOptions());
+}
+
+TEST_CASE("Testing spinning and sleeping threads") {
+  ThreadPool::IdleOptions Options;
+  SUBCASE("Testing default options") {}
+  SUBCASE("Testing threads sleeping immediately") {
+    Options.SpinRounds = 0;
+  }
+
+  ThreadPool::setIdleOptions(Options);
+  ThreadPool::initialize(4);
+
+  /* Workers without tasks stop spinning after a short time and sleep */
+  auto WaitUntilAsleep = []() {
+    auto Until = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (ThreadPool::getSleepingThreads() < 3 && std::chrono::steady_clock::now() < Until)
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    return ThreadPool::getSleepingThreads() == 3 && !ThreadPool::getSpinningThreads();
+  };
+  CHECK(WaitUntilAsleep());
+
+  for (unsigned Burst = 0; Burst < 20; ++Burst) {
+    std::atomic<unsigned> Executed = 0;
+    unsigned MaxSpinning = 0;
+    ThreadPool::post(spawn, 6, std::ref(Executed));
+    while (Executed.load() < 127) {
+      MaxSpinning = std::max(MaxSpinning, ThreadPool::getSpinningThreads());
+      std::this_thread::yield();
+    }
+
+    /* A task posted while the workers spin after the burst is still picked up */
+    ThreadPool::post([&]() { Executed.fetch_add(1); });
+    ThreadPool::awaitCompletion();
+    CHECK(Executed == 128);
+    if (!Options.SpinRounds)
+      CHECK(MaxSpinning == 0);
+    CHECK(WaitUntilAsleep());
+  }
+
+  ThreadPool::shutdown();
+  ThreadPool::setIdleOptions(ThreadPool::IdleOptions());
+}
+
+TEST_CASE("Testing Task") {
+  SUBCASE("Testing reuse of task blocks") {
+    void *Block = TaskAllocator::allocate(sizeof(Task));
+    TaskAllocator::deallocate(Block, sizeof(Task));
+    CHECK(TaskAllocator::allocate(sizeof(Task)) == Block);
+    TaskAllocator::deallocate(Block, sizeof(Task));
+  }
+
+  SUBCASE("Testing discarded tasks") {
+    /* Discarding a task destroys its callable and breaks the promise of its future */
+    auto Counter = std::make_shared<unsigned>(0);
+    auto *State = detail::FutureState<unsigned>::create();
+    TaskFuture<unsigned> Future(State);
+    TaskPtr T(Task::create([Promise = detail::TaskPromise<unsigned>(State), Counter]() mutable {
+      Promise.run([]() { return 1U; });
+    }));
+    CHECK(Counter.use_count() == 2);
+
+    T.reset();
+    CHECK(Counter.use_count() == 1);
+    REQUIRE(Future.isReady());
+    CHECK_THROWS_AS(Future.get(), std::future_error);
+  }
+}
+
+TEST_CASE("Testing task priorities") {
+  /* A single worker, which is blocked until all tasks have been submitted */
+  ThreadPool::initialize(2);
+
+  std::atomic<bool> Started = false;
+  std::atomic<bool> Release = false;
+  ThreadPool::post([&]() {
+    Started = true;
+    while (!Release.load())
+      std::this_thread::yield();
+  });
+  while (!Started.load())
+    std::this_thread::yield();
+
+  /* Only the worker writes to the vector */
+  std::vector<TaskPriority> Order;
+  ThreadPool::postWithPriority(TaskPriority::Background, [&]() { Order.push_back(TaskPriority::Background); });
+  for (unsigned N = 0; N < 100; ++N)
+    ThreadPool::post([&]() { Order.push_back(TaskPriority::Normal); });
+  for (unsigned N = 0; N < 10; ++N)
+    ThreadPool::postWithPriority(TaskPriority::High, [&]() { Order.push_back(TaskPriority::High); });
+
+  Release = true;
+  ThreadPool::awaitCompletion();
+  REQUIRE(Order.size() == 111);
+
+  /* High priority tasks run first, although every few tasks a normal task is preferred */
+  auto LastHigh = std::find(Order.rbegin(), Order.rend(), TaskPriority::High).base() - Order.begin();
+  CHECK(LastHigh <= 14);
+
+  /* The background task does not wait for all normal tasks */
+  auto Background = std::find(Order.begin(), Order.end(), TaskPriority::Background) - Order.begin();
+  CHECK(Background < 20);
+
+  ThreadPool::shutdown();
+}
+
+TEST_CASE("Testing full task queues") {
+  ThreadPool::initialize(2);
+
+  /* The single worker fills the high priority lane, which no other thread empties */
+  std::atomic<unsigned> Executed = 0;
+  ThreadPool::post([&]() {
+    for (unsigned N = 0; N < 10000; ++N)
+      ThreadPool::postWithPriority(TaskPriority::High, [&]() { Executed.fetch_add(1); });
+  });
+  ThreadPool::awaitCompletion();
+  CHECK(Executed == 10000);
+
+  /* While the worker is blocked, the submitting thread executes tasks itself once the queue is full */
+  std::atomic<bool> Started = false;
+  std::atomic<bool> Release = false;
+  ThreadPool::post([&]() {
+    Started = true;
+    while (!Release.load())
+      std::this_thread::yield();
+  });
+  while (!Started.load())
+    std::this_thread::yield();
+
+  Executed = 0;
+  for (unsigned N = 0; N < 10000; ++N)
+    ThreadPool::post([&]() { Executed.fetch_add(1); });
+  CHECK(Executed > 0);
+
+  Release = true;
+  ThreadPool::awaitCompletion();
+  CHECK(Executed == 10000);
+
+  ThreadPool::shutdown();
+}
@@ -0,0 +1,83 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <icarus/Threads/ThreadPool.h>
+
+#include <fstream>
+
+using namespace icarus;
+
+/**
+ * Creates a node directory with a cpulist file in the provided directory.
+ */
+static void writeNode(llvm::StringRef Path, llvm::StringRef Node, llvm::StringRef CPUs) {
+  llvm::SmallString<128> NodePath(Path);
+  llvm::sys::path::append(NodePath, Node);
+  REQUIRE(!llvm::sys::fs::create_directory(NodePath));
+  llvm::sys::path::append(NodePath, "cpulist");
+  std::ofstream(NodePath.str().str()) << CPUs.str() << "\n";
+}
+
+TEST_CASE("Testing CPU topology") {
+  SUBCASE("Testing CPU lists") {
+    CHECK(parseCPUList("3") == std::vector<unsigned>{3});
+    CHECK(parseCPUList("0-3,8,10-11\n") == std::vector<unsigned>{0, 1, 2, 3, 8, 10, 11});
+    CHECK(parseCPUList("4,0") == std::vector<unsigned>{4, 0});
+
+    CHECK_FALSE(parseCPUList(""));
+    CHECK_FALSE(parseCPUList("1,"));
+    CHECK_FALSE(parseCPUList("3-1"));
+    CHECK_FALSE(parseCPUList("a-b"));
+  }
+
+  SUBCASE("Testing nodes of CPUs") {
+    llvm::SmallString<128> Path;
+    REQUIRE(!llvm::sys::fs::createUniqueDirectory("icarus", Path));
+    writeNode(Path, "node0", "0-1,4");
+    writeNode(Path, "node2", "2-3");
+    writeNode(Path, "node3", "");
+    writeNode(Path, "possible", "0-3");
+
+    CPUTopology Topology(Path);
+    CHECK(Topology.getNumNodes() == 3);
+    CHECK(Topology.getNode(1) == 0);
+    CHECK(Topology.getNode(3) == 2);
+    CHECK(Topology.getNode(4) == 0);
+    CHECK(Topology.getNode(100) == 0);
+
+    /* Without node directories, all CPUs are on the same node */
+    CPUTopology Missing(llvm::StringRef(Path.str().str() + "/missing"));
+    CHECK(Missing.getNumNodes() == 1);
+
+    llvm::sys::fs::remove_directories(Path);
+  }
+
+  SUBCASE("Testing tasks placed on nodes") {
+    /* Invalid CPUs are rejected before any thread is pinned */
+    CHECK_FALSE(ThreadPool::pinThreads({}));
+    CHECK_FALSE(ThreadPool::pinThreads({1U << 20}));
+    CHECK(ThreadPool::getNumNodes() == 1);
+
+    /* Without pinned threads, tasks placed on a node are executed like other tasks */
+    ThreadPool::initialize(3);
+    std::atomic<unsigned> Executed = 0;
+    for (unsigned N = 0; N < 100; ++N)
+      ThreadPool::postOnNode(N % 2, [&]() { Executed.fetch_add(1); });
+    ThreadPool::awaitCompletion();
+    CHECK(Executed == 100);
+
+    std::vector<ThreadPool::NodeStatistics> Statistics = ThreadPool::getNodeStatistics();
+    REQUIRE(Statistics.size() == 1);
+    CHECK(Statistics[0].Workers == 2);
+    CHECK(Statistics[0].LocalTasks == 100);
+    CHECK(Statistics[0].RemoteTasks == 0);
+    ThreadPool::shutdown();
+  }
+}
@@ -0,0 +1,82 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <doctest.h>
+
+#include <icarus/Threads/WorkStealingDeque.h>
+
+#include <thread>
+
+using namespace icarus;
+
+TEST_CASE("Testing WorkStealingDeque") {
+  SUBCASE("Testing owner and thief order") {
+    WorkStealingDeque<unsigned> Deque(4);
+    for (unsigned N = 1; N <= 10; ++N)
+      Deque.push(N);
+    CHECK(Deque.size() == 10);
+    CHECK(Deque.capacity() == 16);
+
+    /* The owner takes the newest element, thieves the oldest one */
+    unsigned Value = 0;
+    REQUIRE(Deque.pop(Value));
+    CHECK(Value == 10);
+    REQUIRE(Deque.steal(Value));
+    CHECK(Value == 1);
+
+    for (unsigned N = 9; N >= 2; --N) {
+      REQUIRE(Deque.pop(Value));
+      CHECK(Value == N);
+    }
+    CHECK(Deque.empty());
+    CHECK_FALSE(Deque.pop(Value));
+    CHECK_FALSE(Deque.steal(Value));
+  }
+
+  SUBCASE("Testing concurrent thieves") {
+    constexpr unsigned NumElements = 100000;
+    constexpr unsigned NumThieves = 3;
+
+    WorkStealingDeque<unsigned> Deque(2);
+    std::vector<std::atomic<unsigned>> Taken(NumElements);
+    std::atomic<unsigned> NumTaken = 0;
+
+    std::vector<std::thread> Thieves;
+    for (unsigned N = 0; N < NumThieves; ++N) {
+      Thieves.emplace_back([&]() {
+        unsigned Value;
+        while (NumTaken.load() < NumElements) {
+          if (Deque.steal(Value)) {
+            Taken[Value].fetch_add(1);
+            NumTaken.fetch_add(1);
+          }
+        }
+      });
+    }
+
+    /* The owner pushes all elements and pops every third one itself */
+    unsigned Value;
+    for (unsigned N = 0; N < NumElements; ++N) {
+      Deque.push(N);
+      if (N % 3 == 0 && Deque.pop(Value)) {
+        Taken[Value].fetch_add(1);
+        NumTaken.fetch_add(1);
+      }
+    }
+    while (Deque.pop(Value)) {
+      Taken[Value].fetch_add(1);
+      NumTaken.fetch_add(1);
+    }
+
+    for (std::thread &Thief : Thieves)
+      Thief.join();
+
+    /* Every element has been taken exactly once */
+    CHECK(NumTaken.load() == NumElements);
+    unsigned NumDuplicates = 0;
+    for (std::atomic<unsigned> &Count : Taken)
+      NumDuplicates += Count.load() != 1;
+    CHECK(NumDuplicates == 0);
+  }
+}